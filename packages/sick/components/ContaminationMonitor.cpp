@@ -0,0 +1,112 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    ContaminationMonitor.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "ContaminationMonitor.hpp"
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+void ContaminationMonitor::start() {
+  LOG_INFO("Starting ContaminationMonitor node");
+  m_statistics = std::make_unique<SectorStatistics>(
+      get_sector_count(), static_cast<float>(get_angle_min()),
+      static_cast<float>(get_angle_max()));
+  m_last_publish_time = getTickTime();
+  tickOnMessage(rx_safety_scan());
+}
+
+void ContaminationMonitor::stop() {
+  LOG_INFO("Stopping ContaminationMonitor node");
+}
+
+void ContaminationMonitor::tick() {
+  m_statistics->setHalfLife(get_half_life());
+
+  rx_safety_scan().processAllNewMessages(
+      [this](SafetyScanProto::Reader reader, int64_t, int64_t) {
+        m_statistics->beginScan();
+        for (const auto scan_point :
+             reader.getMeasurementData().getScanPoints()) {
+          const auto status = scan_point.getStatus();
+          m_statistics->addBeam(scan_point.getAngle(),
+                                status.getContamination(),
+                                status.getContaminationWarning(),
+                                status.getGlare());
+        }
+      });
+
+  if (getTickTime() - m_last_publish_time >= get_publish_interval()) {
+    publishHealth();
+    m_last_publish_time = getTickTime();
+  }
+}
+
+void ContaminationMonitor::publishHealth() {
+  const int n_sectors = m_statistics->size();
+
+  auto health = tx_optics_health().initProto();
+  health.setStartAngle(m_statistics->angleMin());
+  health.setSectorWidth(m_statistics->sectorWidth());
+  health.setScans(m_statistics->scans());
+  auto contamination = health.initContamination(n_sectors);
+  auto contamination_warning = health.initContaminationWarning(n_sectors);
+  auto glare = health.initGlare(n_sectors);
+  auto beams = health.initBeams(n_sectors);
+
+  float max_contamination = 0.0f;
+  int max_contamination_sector = 0;
+  for (int i = 0; i < n_sectors; i++) {
+    const SectorStatistics::Sector sector = m_statistics->sector(i);
+    const double n_beams = sector.beams > 0.0 ? sector.beams : 1.0;
+    const float contamination_fraction = sector.contamination / n_beams;
+    contamination.set(i, contamination_fraction);
+    contamination_warning.set(i, sector.contamination_warning / n_beams);
+    glare.set(i, sector.glare / n_beams);
+    beams.set(i, sector.beams);
+
+    if (contamination_fraction > max_contamination) {
+      max_contamination = contamination_fraction;
+      max_contamination_sector = i;
+    }
+  }
+  health.setMaxContamination(max_contamination);
+  health.setMaxContaminationSector(max_contamination_sector);
+
+  tx_optics_health().publish();
+
+  show("max_contamination", max_contamination);
+  show("max_contamination_sector", max_contamination_sector);
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
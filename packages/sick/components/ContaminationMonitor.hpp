@@ -0,0 +1,85 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    ContaminationMonitor.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <memory>
+
+#include "engine/alice/alice_codelet.hpp"
+
+#include "packages/sick/messages/safety_scan.hpp"
+#include "packages/sick/messages/optics_health.hpp"
+#include "packages/sick/gems/sector_statistics.hpp"
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Accumulates exponentially decayed per-sector statistics of the contamination, contamination
+// warning and glare flags of every beam and publishes them as a compact health map at a low rate.
+// This allows to schedule cleaning of the optics cover without logging full scans.
+class ContaminationMonitor : public isaac::alice::Codelet
+{
+public:
+    void start() override;
+    void tick() override;
+    void stop() override;
+
+    // Safety scan from the SickSafetyScanner codelet. Requires measurement data.
+    ISAAC_PROTO_RX(SafetyScanProto, safety_scan);
+    // Per-sector health map.
+    ISAAC_PROTO_TX(OpticsHealthProto, optics_health);
+
+    // Number of angular sectors.
+    ISAAC_PARAM(int, sector_count, 36);
+    // Field of view covered by the sectors [radians].
+    ISAAC_PARAM(double, angle_min, -2.4);
+    ISAAC_PARAM(double, angle_max, 2.4);
+    // Number of scans after which a sample has half of its initial weight.
+    ISAAC_PARAM(double, half_life, 3000.0);
+    // Interval between two published health maps [seconds].
+    ISAAC_PARAM(double, publish_interval, 10.0);
+
+private:
+    // Publishes the current statistics.
+    void publishHealth();
+
+    std::unique_ptr<SectorStatistics> m_statistics;
+    double m_last_publish_time{0.0};
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
+
+ISAAC_ALICE_REGISTER_CODELET(isaac::sick_safetyscanners::ContaminationMonitor);
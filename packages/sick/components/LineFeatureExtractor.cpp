@@ -0,0 +1,119 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    LineFeatureExtractor.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "LineFeatureExtractor.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+void LineFeatureExtractor::start() {
+  LOG_INFO("Starting LineFeatureExtractor node");
+  m_truncated_scans = 0;
+  tickOnMessage(rx_flatscan());
+}
+
+void LineFeatureExtractor::stop() {
+  LOG_INFO("Stopping LineFeatureExtractor node");
+}
+
+void LineFeatureExtractor::tick() {
+  const auto deadline =
+      std::chrono::steady_clock::now() +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double, std::milli>(
+              std::max(get_compute_budget(), 0.0)));
+
+  LineExtractionParams params;
+  params.split_threshold = static_cast<float>(get_split_threshold());
+  params.max_gap = static_cast<float>(get_max_gap());
+  params.min_points = get_min_points();
+  params.min_length = static_cast<float>(get_min_length());
+  params.merge_angle = static_cast<float>(get_merge_angle());
+  params.merge_distance = static_cast<float>(get_merge_distance());
+  params.range_noise = static_cast<float>(get_range_noise());
+  params.max_segments =
+      static_cast<std::size_t>(std::max(get_max_segments(), 0));
+  m_extractor.setParams(params);
+
+  auto proto = rx_flatscan().getProto();
+  const auto ranges = proto.getRanges();
+  const auto angles = proto.getAngles();
+  const std::size_t n_beams = std::min(ranges.size(), angles.size());
+  m_ranges.resize(n_beams);
+  m_angles.resize(n_beams);
+  for (std::size_t i = 0; i < n_beams; i++) {
+    m_ranges[i] = ranges[i];
+    m_angles[i] = angles[i];
+  }
+
+  const bool complete = m_extractor.extract(
+      m_angles, m_ranges, static_cast<float>(proto.getInvalidRangeThreshold()),
+      static_cast<float>(proto.getOutOfRangeThreshold()), deadline);
+  if (!complete) {
+    m_truncated_scans++;
+  }
+
+  const auto &segments = m_extractor.segments();
+  auto segments_proto = tx_line_segments().initProto();
+  segments_proto.setBeams(n_beams);
+  segments_proto.setTruncated(!complete);
+  auto segments_builder = segments_proto.initSegments(segments.size());
+  for (std::size_t i = 0; i < segments.size(); i++) {
+    const LineSegment &segment = segments[i];
+    auto builder = segments_builder[i];
+    builder.setStartX(segment.start_x);
+    builder.setStartY(segment.start_y);
+    builder.setEndX(segment.end_x);
+    builder.setEndY(segment.end_y);
+    builder.setAlpha(segment.alpha);
+    builder.setR(segment.r);
+    builder.setVarAlpha(segment.var_alpha);
+    builder.setCovAlphaR(segment.cov_alpha_r);
+    builder.setVarR(segment.var_r);
+    builder.setRmsError(segment.rms_error);
+    builder.setFirstBeam(segment.first_beam);
+    builder.setLastBeam(segment.last_beam);
+    builder.setPointCount(segment.point_count);
+  }
+  tx_line_segments().publish(rx_flatscan().acqtime());
+
+  show("segments", static_cast<int>(segments.size()));
+  show("truncated_scans", m_truncated_scans);
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
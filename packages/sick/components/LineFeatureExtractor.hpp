@@ -0,0 +1,95 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    LineFeatureExtractor.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <vector>
+
+#include "engine/alice/alice_codelet.hpp"
+#include "messages/messages.hpp"
+
+#include "packages/sick/messages/line_segments.hpp"
+#include "packages/sick/gems/line_extraction.hpp"
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Extracts line segments (walls, shelves) from every flatscan with split-and-merge and publishes
+// them with their covariance. A segment list is about two orders of magnitude smaller than the
+// scan, so consumers which only need line features do not have to receive every beam.
+class LineFeatureExtractor : public isaac::alice::Codelet
+{
+public:
+    void start() override;
+    void tick() override;
+    void stop() override;
+
+    // Flatscan from the SickSafetyScanner codelet.
+    ISAAC_PROTO_RX(FlatscanProto, flatscan);
+    // Line segments of the scan in the sensor frame.
+    ISAAC_PROTO_TX(LineSegmentsProto, line_segments);
+
+    // Maximum distance of a point to the chord of its segment before the segment is split
+    // [meters].
+    ISAAC_PARAM(double, split_threshold, 0.03);
+    // Maximum distance between two consecutive points of a segment [meters].
+    ISAAC_PARAM(double, max_gap, 0.2);
+    // Minimum number of points and length of a segment [meters].
+    ISAAC_PARAM(int, min_points, 6);
+    ISAAC_PARAM(double, min_length, 0.3);
+    // Neighbouring segments whose lines differ by less than these values are merged
+    // [radians, meters].
+    ISAAC_PARAM(double, merge_angle, 0.05);
+    ISAAC_PARAM(double, merge_distance, 0.05);
+    // Standard deviation of a range measurement [meters].
+    ISAAC_PARAM(double, range_noise, 0.01);
+    // Maximum number of segments per scan. If exceeded, the message is marked as truncated.
+    ISAAC_PARAM(int, max_segments, 64);
+    // Compute time per scan [milliseconds]. If exceeded, the segments found so far are published
+    // and the message is marked as truncated.
+    ISAAC_PARAM(double, compute_budget, 2.0);
+
+private:
+    LineExtractor m_extractor;
+    std::vector<float> m_angles;
+    std::vector<float> m_ranges;
+    int m_truncated_scans{0};
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
+
+ISAAC_ALICE_REGISTER_CODELET(isaac::sick_safetyscanners::LineFeatureExtractor);
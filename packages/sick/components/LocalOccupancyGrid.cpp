@@ -0,0 +1,133 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    LocalOccupancyGrid.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "LocalOccupancyGrid.hpp"
+
+#include <algorithm>
+
+#include "engine/core/time.hpp"
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+void LocalOccupancyGrid::start() {
+  LOG_INFO("Starting LocalOccupancyGrid node");
+  m_grid = std::make_unique<RollingOccupancyGrid>(
+      get_grid_size(), static_cast<float>(get_cell_size()));
+  m_scans_since_full_grid = 0;
+  tickOnMessage(rx_flatscan());
+}
+
+void LocalOccupancyGrid::stop() {
+  LOG_INFO("Stopping LocalOccupancyGrid node");
+}
+
+void LocalOccupancyGrid::tick() {
+  m_grid->setLogOdds(get_log_odds_hit(), get_log_odds_miss(),
+                     get_log_odds_limit());
+
+  auto proto = rx_flatscan().getProto();
+  const auto ranges = proto.getRanges();
+  const auto angles = proto.getAngles();
+  const std::size_t n_beams = std::min(ranges.size(), angles.size());
+  m_ranges.resize(n_beams);
+  m_angles.resize(n_beams);
+  for (std::size_t i = 0; i < n_beams; i++) {
+    m_ranges[i] = ranges[i];
+    m_angles[i] = angles[i];
+  }
+
+  float sensor_x = 0.0f;
+  float sensor_y = 0.0f;
+  float sensor_yaw = 0.0f;
+  const auto world_T_lidar =
+      try_get_world_T_lidar(ToSeconds(rx_flatscan().acqtime()));
+  if (world_T_lidar) {
+    sensor_x = world_T_lidar->translation.x();
+    sensor_y = world_T_lidar->translation.y();
+    sensor_yaw = world_T_lidar->rotation.angle();
+  } else if (!m_pose_warning_shown) {
+    LOG_WARNING("Pose world_T_lidar is not available. The occupancy grid "
+                "stays centred at the origin.");
+    m_pose_warning_shown = true;
+  }
+
+  m_grid->recenter(sensor_x, sensor_y);
+  m_grid->insertScan(sensor_x, sensor_y, sensor_yaw, m_angles, m_ranges,
+                     static_cast<float>(proto.getInvalidRangeThreshold()),
+                     static_cast<float>(proto.getOutOfRangeThreshold()),
+                     static_cast<float>(get_max_range()));
+
+  show("dirty_tiles", m_grid->dirtyTileCount());
+
+  const int full_grid_interval = get_full_grid_interval();
+  if (full_grid_interval > 0 &&
+      ++m_scans_since_full_grid >= full_grid_interval) {
+    m_scans_since_full_grid = 0;
+    m_regions.assign(1, m_grid->window());
+    publishPatch(m_regions, true);
+  } else if (m_grid->dirtyTileCount() > 0) {
+    m_grid->dirtyRegions(m_regions);
+    publishPatch(m_regions, false);
+  }
+  m_grid->clearDirtyTiles();
+}
+
+void LocalOccupancyGrid::publishPatch(const std::vector<CellRegion> &regions,
+                                      bool is_full_grid) {
+  const CellRegion window = m_grid->window();
+
+  auto patch = tx_grid_patch().initProto();
+  patch.setCellSize(m_grid->cellSize());
+  patch.setGridOriginX(window.min_x);
+  patch.setGridOriginY(window.min_y);
+  patch.setGridSize(m_grid->size());
+  patch.setIsFullGrid(is_full_grid);
+
+  auto tiles = patch.initTiles(regions.size());
+  for (std::size_t i = 0; i < regions.size(); i++) {
+    const CellRegion &region = regions[i];
+    auto tile = tiles[i];
+    tile.setOriginX(region.min_x);
+    tile.setOriginY(region.min_y);
+    tile.setWidth(region.width());
+    tile.setHeight(region.height());
+    auto log_odds = tile.initLogOdds(region.width() * region.height());
+    m_grid->copyRegion(region, reinterpret_cast<int8_t *>(log_odds.begin()));
+  }
+
+  tx_grid_patch().publish(rx_flatscan().acqtime());
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
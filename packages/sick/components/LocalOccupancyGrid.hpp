@@ -0,0 +1,96 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    LocalOccupancyGrid.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "engine/alice/alice_codelet.hpp"
+#include "messages/messages.hpp"
+
+#include "packages/sick/messages/occupancy_grid.hpp"
+#include "packages/sick/gems/rolling_occupancy_grid.hpp"
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Ray casts every received flatscan into a rolling occupancy grid centred at the sensor and
+// publishes the 16x16 tiles which changed with this scan. Every full_grid_interval scans the whole
+// grid is published so that late subscribers can catch up.
+class LocalOccupancyGrid : public isaac::alice::Codelet
+{
+public:
+    void start() override;
+    void tick() override;
+    void stop() override;
+
+    // Flatscan from the SickSafetyScanner codelet.
+    ISAAC_PROTO_RX(FlatscanProto, flatscan);
+    // Changed tiles of the occupancy grid, in world cell coordinates.
+    ISAAC_PROTO_TX(OccupancyGridPatchProto, grid_patch);
+
+    // Pose of the sensor in the frame of the grid. If unavailable, the grid stays at the origin.
+    ISAAC_POSE2(world, lidar);
+
+    // Number of cells of the grid along each axis. Rounded up to a multiple of 16.
+    ISAAC_PARAM(int, grid_size, 256);
+    // Edge length of a single cell [meters].
+    ISAAC_PARAM(double, cell_size, 0.05);
+    // Beams are ray cast up to this range [meters].
+    ISAAC_PARAM(double, max_range, 20.0);
+    // Log-odds added to a cell for a hit and subtracted for a miss, and their absolute limit.
+    ISAAC_PARAM(int, log_odds_hit, 20);
+    ISAAC_PARAM(int, log_odds_miss, 5);
+    ISAAC_PARAM(int, log_odds_limit, 100);
+    // Number of scans between two publications of the full grid. 0 disables them.
+    ISAAC_PARAM(int, full_grid_interval, 50);
+
+private:
+    // Publishes the given regions of the grid.
+    void publishPatch(const std::vector<CellRegion> &regions, bool is_full_grid);
+
+    std::unique_ptr<RollingOccupancyGrid> m_grid;
+    std::vector<float> m_angles;
+    std::vector<float> m_ranges;
+    std::vector<CellRegion> m_regions;
+    int m_scans_since_full_grid{0};
+    bool m_pose_warning_shown{false};
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
+
+ISAAC_ALICE_REGISTER_CODELET(isaac::sick_safetyscanners::LocalOccupancyGrid);
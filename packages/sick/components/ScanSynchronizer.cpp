@@ -0,0 +1,140 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    ScanSynchronizer.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "ScanSynchronizer.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+void ScanSynchronizer::start() {
+  LOG_INFO("Starting ScanSynchronizer node");
+  m_inputs = {&rx_scan_0(), &rx_scan_1(), &rx_scan_2(), &rx_scan_3()};
+
+  const int sensor_count = get_sensor_count();
+  if (sensor_count < 2 || sensor_count > static_cast<int>(kMaxSensors)) {
+    reportFailure("sensor_count must be in [2, %zu], got %d", kMaxSensors,
+                  sensor_count);
+    return;
+  }
+  const std::size_t ring_size =
+      static_cast<std::size_t>(std::max(get_ring_size(), 1));
+  m_buffer.configure(sensor_count, ring_size,
+                     static_cast<int64_t>(get_tolerance() * 1e6), //  ms -> ns
+                     get_use_sensor_time()
+                         ? ScanAlignmentBuffer::TimeSource::kSensor
+                         : ScanAlignmentBuffer::TimeSource::kAcqtime);
+  m_scans.assign(sensor_count, {});
+  for (auto &ring : m_scans) {
+    ring.resize(ring_size);
+  }
+
+  for (int i = 0; i < sensor_count; i++) {
+    tickOnMessage(*m_inputs[i]);
+  }
+}
+
+void ScanSynchronizer::stop() {
+  LOG_INFO("Stopping ScanSynchronizer node");
+  m_scans.clear();
+}
+
+void ScanSynchronizer::tick() {
+  for (std::size_t i = 0; i < m_buffer.sensorCount(); i++) {
+    m_inputs[i]->processAllNewMessages(
+        [this, i](SafetyScanProto::Reader reader, int64_t, int64_t acqtime) {
+          store(i, reader, acqtime);
+        });
+  }
+
+  if (m_buffer.match(m_slots)) {
+    publish(m_slots);
+  }
+
+  show("sets", static_cast<int>(m_buffer.matchCount()));
+  show("spread", m_buffer.spread() * 1e-6); //  ns -> ms
+  for (std::size_t i = 0; i < m_buffer.sensorCount(); i++) {
+    const std::string sensor = "sensor_" + std::to_string(i);
+    show(sensor + ".lost_scans", static_cast<int>(m_buffer.lostScans(i)));
+    show(sensor + ".duplicate_scans",
+         static_cast<int>(m_buffer.duplicateScans(i)));
+  }
+}
+
+void ScanSynchronizer::store(std::size_t sensor,
+                             SafetyScanProto::Reader reader, int64_t acqtime) {
+  const auto header = reader.getHeader();
+  ScanStamp stamp;
+  stamp.scan_number = header.getScanNumber();
+  stamp.sensor_time = SensorTime(header.getTimestamp().getDate(),
+                                 header.getTimestamp().getTime());
+  stamp.acqtime = acqtime;
+  const int slot = m_buffer.push(sensor, stamp);
+  if (slot < 0) {
+    return;
+  }
+
+  // A fresh message whose first segment holds the whole scan, so that the
+  // copy needs a single allocation and the memory of the previous scan in the
+  // slot is released.
+  auto &message = m_scans[sensor][slot];
+  message = std::make_unique<::capnp::MallocMessageBuilder>(
+      reader.totalSize().wordCount + 1);
+  message->setRoot(reader);
+}
+
+void ScanSynchronizer::publish(const std::vector<int> &slots) {
+  const std::size_t n_sensors = slots.size();
+  auto proto = tx_synchronized_scans().initProto();
+  auto scans = proto.initScans(n_sensors);
+  auto times = proto.initTimes(n_sensors);
+  auto acqtimes = proto.initAcqtimes(n_sensors);
+  int64_t newest = 0;
+  for (std::size_t i = 0; i < n_sensors; i++) {
+    const int slot = slots[i];
+    scans.setWithCaveats(
+        i, m_scans[i][slot]->getRoot<SafetyScanProto>().asReader());
+    times.set(i, m_buffer.time(i, slot));
+    acqtimes.set(i, m_buffer.stamp(i, slot).acqtime);
+    newest = i == 0 ? m_buffer.time(i, slot)
+                    : std::max(newest, m_buffer.time(i, slot));
+  }
+  proto.setSpread(m_buffer.spread());
+  tx_synchronized_scans().publish(newest);
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,103 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    ScanSynchronizer.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "capnp/message.h"
+#include "engine/alice/alice_codelet.hpp"
+#include "messages/messages.hpp"
+
+#include "packages/sick/messages/safety_scan.hpp"
+#include "packages/sick/messages/synchronized_scans.hpp"
+#include "packages/sick/gems/scan_alignment.hpp"
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Matches the scans of up to four SickSafetyScanner codelets by time and publishes sets with one
+// scan per sensor. The latest scans of every sensor are kept in a ring of fixed size, so a set is
+// only published once all of its scans have arrived and no queue grows if the sensors or the
+// consumers are slow. Every tick publishes at most the newest set which has not been published
+// yet; older sets are skipped.
+class ScanSynchronizer : public isaac::alice::Codelet
+{
+public:
+    void start() override;
+    void tick() override;
+    void stop() override;
+
+    // Safety scans of the sensors. Only the first sensor_count inputs are used.
+    ISAAC_PROTO_RX(SafetyScanProto, scan_0);
+    ISAAC_PROTO_RX(SafetyScanProto, scan_1);
+    ISAAC_PROTO_RX(SafetyScanProto, scan_2);
+    ISAAC_PROTO_RX(SafetyScanProto, scan_3);
+    // Matched scans, published with the newest aligned time of the set as acqtime.
+    ISAAC_PROTO_TX(SynchronizedScansProto, synchronized_scans);
+
+    // Number of sensors in [2, 4]. Only considered on start.
+    ISAAC_PARAM(int, sensor_count, 2);
+    // Number of recent scans kept per sensor. Only considered on start.
+    ISAAC_PARAM(int, ring_size, 8);
+    // Maximum difference between the times of the scans of a set [milliseconds]. Should be less
+    // than half the scan period. Only considered on start.
+    ISAAC_PARAM(double, tolerance, 10.0);
+    // If enabled, scans are aligned by the timestamps of their data headers mapped to the
+    // application clock, otherwise by their receive times. Only considered on start.
+    ISAAC_PARAM(bool, use_sensor_time, true);
+
+private:
+    static constexpr std::size_t kMaxSensors = 4;
+
+    // Copies a received scan into the ring of its sensor.
+    void store(std::size_t sensor, SafetyScanProto::Reader reader, int64_t acqtime);
+    // Publishes the scans in the given ring slots.
+    void publish(const std::vector<int> &slots);
+
+    std::array<isaac::alice::ProtoRx<SafetyScanProto> *, kMaxSensors> m_inputs{};
+    ScanAlignmentBuffer m_buffer;
+    // Copies of the scans in the rings, indexed by sensor and slot.
+    std::vector<std::vector<std::unique_ptr<::capnp::MallocMessageBuilder>>> m_scans;
+    std::vector<int> m_slots;
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
+
+ISAAC_ALICE_REGISTER_CODELET(isaac::sick_safetyscanners::ScanSynchronizer);
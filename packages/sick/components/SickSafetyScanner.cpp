@@ -34,242 +34,1333 @@
 #include "SickSafetyScanner.hpp"
 #include "messages/tensor.hpp"
 #include <algorithm>
+#include <fstream>
+#include <thread>
 #include <sick_safetyscanners_base/Exceptions.h>
 #include <sick_safetyscanners_base/Types.h>
 
 namespace isaac {
 namespace sick_safetyscanners {
 
-void SickSafetyScanner::start() {
-  LOG_INFO("Starting SickSafetyScanner node");
+namespace {
+
+// The microScan3 supports up to four measurement channels.
+constexpr std::size_t kMaxAdditionalChannels = 3;
+
+// Reads the parameters of a channel from a JSON object. Missing values are taken from defaults.
+ConfigurationParams ParseChannelParams(const nlohmann::json &json,
+                                       const ConfigurationParams &defaults) {
+  ConfigurationParams params;
+  params.channel = json.value("channel", defaults.channel);
+  params.channel_enabled =
+      json.value("channel_enabled", defaults.channel_enabled);
+  params.angle_offset = json.value("angle_offset", defaults.angle_offset);
+  params.angle_start = json.value("angle_start", defaults.angle_start);
+  params.angle_end = json.value("angle_end", defaults.angle_end);
+  params.general_system_state =
+      json.value("general_system_state", defaults.general_system_state);
+  params.derived_settings =
+      json.value("derived_settings", defaults.derived_settings);
+  params.measurement_data =
+      json.value("measurement_data", defaults.measurement_data);
+  params.intrusion_data = json.value("intrusion_data", defaults.intrusion_data);
+  params.application_io_data =
+      json.value("application_io_data", defaults.application_io_data);
+  params.publishing_frequency_factor = json.value(
+      "publishing_frequency_factor", defaults.publishing_frequency_factor);
+  return params;
+}
 
-  sick::types::ip_address_t sensor_ip{
-      boost::asio::ip::address_v4::from_string(get_sensor_ip())};
+nlohmann::json ToJson(const ConfigurationParams &params) {
+  nlohmann::json json;
+  json["channel"] = params.channel;
+  json["channel_enabled"] = params.channel_enabled;
+  json["angle_offset"] = params.angle_offset;
+  json["angle_start"] = params.angle_start;
+  json["angle_end"] = params.angle_end;
+  json["general_system_state"] = params.general_system_state;
+  json["derived_settings"] = params.derived_settings;
+  json["measurement_data"] = params.measurement_data;
+  json["intrusion_data"] = params.intrusion_data;
+  json["application_io_data"] = params.application_io_data;
+  json["publishing_frequency_factor"] = params.publishing_frequency_factor;
+  return json;
+}
+
+// Blocking ticks wait at most this long at once, so that stopping the node is
+// neither delayed by receive_timeout nor by a pending request.
+constexpr std::chrono::milliseconds kWaitSlice{50};
+
+// The requests below block until the sensor answers or the request times out.
+// They run on a helper thread, only use their arguments and return errors in
+// the reply, as they may outlive the codelet.
+
+// Reads the type code and, if requested, the persistent configuration.
+void QueryIdentity(sick::SyncSickSafetyScanner &scanner, bool read_config,
+                   SensorReply &reply) {
+  try {
+    scanner.requestTypeCode(reply.type_code);
+    reply.has_type_code = true;
+  } catch (const sick::runtime_error &e) {
+    reply.error =
+        std::string("Error during requesting sensor type code: ") + e.what();
+    return;
+  }
+  if (read_config) {
+    try {
+      scanner.requestPersistentConfig(reply.config_data);
+      reply.has_config_data = true;
+    } catch (const sick::runtime_error &e) {
+      reply.error =
+          std::string("Error during requesting sensor persistent config: ") +
+          e.what();
+      return;
+    }
+  }
+  reply.ok = true;
+}
 
+SensorReply ConnectSensor(sick::types::ip_address_t sensor_ip, int tcp_port,
+                          sick::datastructure::CommSettings comm_settings,
+                          bool query_identity, bool read_config) {
+  SensorReply reply;
   try {
-    m_scanner = std::make_unique<sick::SyncSickSafetyScanner>(
-        sensor_ip, get_tcp_port(), m_comm_settings);
+    reply.scanner = std::make_shared<sick::SyncSickSafetyScanner>(
+        sensor_ip, tcp_port, comm_settings);
   } catch (const sick::timeout_error &e) {
-    reportFailure("Could not connect to SICK safety scanner: %s", e.what());
+    reply.error =
+        std::string("Could not connect to SICK safety scanner: ") + e.what();
+    return reply;
   } catch (const std::exception &e) {
-    reportFailure("An unexpected error occured: %s", e.what());
+    reply.error = std::string("An unexpected error occured: ") + e.what();
+    return reply;
+  }
+  if (query_identity) {
+    QueryIdentity(*reply.scanner, read_config, reply);
+  } else {
+    reply.ok = true;
   }
+  return reply;
+}
 
-  // Fetch sensor type info from device
-  readTypeCodeSettings();
+SensorReply
+ChangeSensorSettings(std::shared_ptr<sick::SyncSickSafetyScanner> scanner,
+                     std::vector<sick::datastructure::CommSettings> settings) {
+  SensorReply reply;
+  for (auto &channel_settings : settings) {
+    try {
+      scanner->changeSensorSettings(channel_settings);
+      reply.settings_applied.push_back(true);
+    } catch (const sick::runtime_error &e) {
+      reply.error =
+          std::string("Error during updating sensor settings: ") + e.what();
+      reply.settings_applied.push_back(false);
+    }
+  }
+  reply.ok = reply.error.empty();
+  return reply;
+}
 
-  if (get_use_persistent_config()) {
-    readConfigFromDevice();
+SensorReply FindSensor(std::shared_ptr<sick::SyncSickSafetyScanner> scanner,
+                       uint16_t blink_time) {
+  SensorReply reply;
+  try {
+    scanner->findSensor(blink_time);
+    reply.ok = true;
+  } catch (const sick::runtime_error &e) {
+    reply.error =
+        std::string("Error while executing find-me command on sensor: ") +
+        e.what();
   }
+  return reply;
+}
+
+} // namespace
+
+void SickSafetyScanner::start() {
+  LOG_INFO("Starting SickSafetyScanner node");
 
-  tickBlocking();
+  m_channels.resize(1);
+  m_channels.front().tx_flatscan = &tx_flatscan();
+  m_channels.front().tx_safety_scan = &tx_safety_scan();
+  m_channels.front().tx_output_path = &tx_output_path();
+
+  loadDeviceCache();
+
+  m_reactor_mode = get_reactor_mode();
+  if (m_reactor_mode && !get_direct_decoder_active()) {
+    LOG_INFO("The reactor mode receives with the direct decoder");
+  }
+
+  // The first tick connects to the sensor.
+  if (m_reactor_mode) {
+    // Ticks never block, so the codelet only occupies a worker thread while
+    // datagrams are processed. ISAAC ticks a codelet only periodically, on
+    // messages or blocking, and messages can only be published from within
+    // tick(). A receive thread could thus not wake the codelet through a
+    // channel, so the socket is polled instead.
+    tickPeriodically(std::max(get_reactor_poll_interval(), 0.1) * 1e-3);
+  } else {
+    tickBlocking();
+  }
 } // namespace sick_safetyscanners
 
 void SickSafetyScanner::tick() {
-  if (isFirstTick() || isParamSetDirty()) {
-    updatePrevParams();
-    updateDeviceConfig();
+  // Ticks of a blocking codelet always run on the same thread, so the
+  // settings are applied on the first one.
+  if (!m_realtime_applied) {
+    applyRealtimeSettings();
+    m_realtime_applied = true;
   }
 
-  try {
-    sick::datastructure::Data data = m_scanner->receive(
-        boost::posix_time::milliseconds(get_receive_timeout()));
-    if (get_flatscan_pub_active()) {
-      publishFlatScanProto(data);
-    }
-    if (get_safety_pub_active()) {
-      publishSafetyScan(data);
+  // Requests to the sensor run on a helper thread. While one is in flight,
+  // the tick only checks for its reply and does not use the scanner.
+  if (m_reply.valid() && !collectReply()) {
+    return;
+  }
+  if (!m_scanner) {
+    reconnect();
+    return;
+  }
+
+  const bool primary_dirty = !m_device_configured || isParamSetDirty();
+  bool configure_primary = false;
+  if (primary_dirty) {
+    updatePrevParams();
+    m_channels.front().params = m_prev_params;
+    // Right after a start from cache the sensor may still be streaming with
+    // the last applied settings, so configuring it is deferred until the
+    // first receive times out.
+    if (m_awaiting_cached_stream && !m_device_configured) {
+      m_device_configured = true;
+    } else {
+      configure_primary = true;
     }
-    if (get_outputpath_pub_active()) {
-      publishOutputPath(data);
+  }
+  const bool configure_additional =
+      primary_dirty || get_additional_channels() != m_prev_additional_channels;
+  if ((configure_primary || configure_additional) &&
+      requestConfiguration(configure_primary, configure_additional)) {
+    return;
+  }
+
+  updateSharedMemory();
+
+  MeasurementChannel &primary = m_channels.front();
+  primary.flatscan_pub_active = get_flatscan_pub_active();
+  primary.safety_pub_active = get_safety_pub_active();
+  primary.outputpath_pub_active = get_outputpath_pub_active();
+
+  const int receive_timeout =
+      m_awaiting_cached_stream
+          ? std::min(get_receive_timeout(), get_cached_stream_timeout())
+          : get_receive_timeout();
+
+  if (m_reactor_mode) {
+    if (!drainDatagrams(receive_timeout)) {
+      return;
     }
-  } catch (const sick::timeout_error &e) {
-    reportFailure("Timeout while waiting to receive sensor data (UDP)");
-  } catch (const sick::runtime_error&e) {
-    reportFailure("An error occured %s", e.what());
+  } else if (!receiveBlocking(receive_timeout)) {
+    return;
   }
 
-  if (rx_find_me_cmd().available()) {
+  publishDueBatches();
+
+  // A find-me command waits until the request in flight has been answered.
+  if (!m_reply.valid() && rx_find_me_cmd().available()) {
     rx_find_me_cmd().processLatestNewMessage(
         [this](FindMeCommandProto::Reader reader, int64_t pubtime,
                int64_t acqtime) {
           uint16_t blink_time = reader.getBlinkTime();
           LOG_INFO("Sending find-me command with blink_time=%d [seconds]",
                    blink_time);
-          try {
-            m_scanner->findSensor(blink_time);
-          } catch (const sick::runtime_error &e) {
-            reportFailure("Error while executing find-me command on sensor: %s",
-                          e.what());
-          }
+          const auto scanner = m_scanner;
+          startRequest(SensorRequest::kFindMe, [scanner, blink_time]() {
+            return FindSensor(scanner, blink_time);
+          });
         });
   }
 }
 
-void SickSafetyScanner::stop() { LOG_INFO("Stopping SickSafetyScanner node"); }
+void SickSafetyScanner::applyRealtimeSettings() {
+  std::string error;
+  const std::vector<int> cpus = get_cpu_affinity();
+  const int priority = get_realtime_priority();
+  if (m_reactor_mode && (!cpus.empty() || priority != 0)) {
+    LOG_WARNING("cpu_affinity and realtime_priority are ignored in reactor "
+                "mode");
+  } else {
+    if (!cpus.empty() && !PinCurrentThread(cpus, error)) {
+      LOG_WARNING("Could not set the CPU affinity: %s", error.c_str());
+    }
+    if (priority != 0 && !SetCurrentThreadFifoPriority(priority, error)) {
+      LOG_WARNING("Could not set SCHED_FIFO priority %d: %s. Continuing with "
+                  "the default scheduling.",
+                  priority, error.c_str());
+    }
+  }
+  std::vector<int> requested_cpus = cpus;
+  std::sort(requested_cpus.begin(), requested_cpus.end());
+  requested_cpus.erase(
+      std::unique(requested_cpus.begin(), requested_cpus.end()),
+      requested_cpus.end());
+  const std::vector<int> affinity = CurrentThreadAffinity();
+  show("realtime.cpus", static_cast<int>(affinity.size()));
+  show("realtime.pinned",
+       !requested_cpus.empty() && affinity == requested_cpus ? 1 : 0);
+  show("realtime.priority", CurrentThreadFifoPriority());
+
+  bool memory_locked = false;
+  if (get_lock_memory()) {
+    memory_locked = LockProcessMemory(error);
+    if (!memory_locked) {
+      LOG_WARNING("Could not lock the process memory: %s", error.c_str());
+    }
+  }
+  show("realtime.memory_locked", memory_locked ? 1 : 0);
+}
+
+bool SickSafetyScanner::receiveScan(int timeout,
+                                    sick::datastructure::Data &data) {
+  if (!m_direct_decoder_active) {
+    try {
+      data = m_scanner->receive(boost::posix_time::milliseconds(timeout));
+    } catch (const sick::timeout_error &e) {
+      return false;
+    }
+    return true;
+  }
 
-void SickSafetyScanner::readTypeCodeSettings() {
-  sick::datastructure::TypeCode type_code;
+  if (!m_datagram_receiver.receive(std::chrono::milliseconds(timeout))) {
+    return false;
+  }
+  if (m_datagram_capture.is_open()) {
+    WriteScanDatagramCapture(m_datagram_capture, m_datagram_receiver.payload());
+  }
+  data = ParseScanDatagram(m_datagram_receiver.payload());
+  return true;
+}
+
+bool SickSafetyScanner::processScan(
+    sick::datastructure::Data &data,
+    std::chrono::steady_clock::time_point wait_start) {
+  const auto received = std::chrono::steady_clock::now();
+
+  m_consecutive_timeouts = 0;
+  m_awaiting_cached_stream = false;
+  if (!m_identity_validated && !validateDeviceIdentity(data)) {
+    return false;
+  }
+
+  MeasurementChannel &channel = channelOf(data);
+  const bool adaptive = get_adaptive_rate_active();
+  const bool publish_flatscan =
+      channel.flatscan_pub_active &&
+      (!adaptive || channel.flatscan_decimator.tick());
+  // The beams are only extracted if they are needed apart from the safety
+  // scan, and only once for all outputs.
+  const bool batch = get_batch_pub_active();
+  const bool publish_visualization = isVisualizationDue(channel);
+  if (publish_flatscan || publish_visualization || batch ||
+      m_shared_ring.isOpen()) {
+    extractScanBeams(data, channel);
+  }
+  if (publish_flatscan) {
+    publishFlatScanProto(data, channel);
+  }
+  if (publish_visualization) {
+    publishVisualization(data, channel);
+  }
+  if (channel.safety_pub_active) {
+    publishSafetyScan(data, channel);
+  }
+  if (channel.outputpath_pub_active) {
+    publishOutputPath(data, channel);
+  }
+  if (m_shared_ring.isOpen()) {
+    publishSharedMemory(data, channel);
+  }
+  if (batch) {
+    appendToBatch(data, channel);
+  }
+
+  if (adaptive) {
+    const auto published = std::chrono::steady_clock::now();
+    updateAdaptiveRate(
+        std::chrono::duration<double>(published - received).count(),
+        std::chrono::duration<double>(received - wait_start).count());
+  }
+  return true;
+}
+
+bool SickSafetyScanner::drainDatagrams(int timeout) {
+  const auto now = std::chrono::steady_clock::now();
+  // The first scan has been waited for since the previous tick, all further
+  // scans were already queued.
+  auto wait_start = m_last_drain;
+  bool received = false;
   try {
-    m_scanner->requestTypeCode(type_code);
+    sick::datastructure::Data data;
+    while (receiveScan(0, data)) {
+      if (!processScan(data, wait_start)) {
+        return false;
+      }
+      wait_start = std::chrono::steady_clock::now();
+      received = true;
+    }
   } catch (const sick::runtime_error &e) {
-    reportFailure("Error during requesting sensor type code: %s", e.what());
+    reportFailure("An error occured %s", e.what());
   }
-  m_range_min = 0.1;
-  m_range_max = type_code.getMaxRange();
-  m_e_interface_type = type_code.getInterfaceType();
+  m_last_drain = std::chrono::steady_clock::now();
+
+  if (received) {
+    m_last_scan = now;
+    return true;
+  }
+  if (now - m_last_scan < std::chrono::milliseconds(timeout)) {
+    return true;
+  }
+  m_last_scan = now;
+  return handleReceiveTimeout();
 }
 
-void SickSafetyScanner::readConfigFromDevice() {
-  sick::datastructure::ConfigData config_data;
+bool SickSafetyScanner::receiveBlocking(int timeout) {
+  // The receive_timeout is measured from the last scan, so waiting in slices
+  // does not change when a timeout is handled.
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - m_last_scan)
+                           .count();
+  const int wait = static_cast<int>(std::max<int64_t>(
+      std::min<int64_t>(timeout - elapsed, kWaitSlice.count()), 0));
   try {
-    m_scanner->requestPersistentConfig(config_data);
+    sick::datastructure::Data data;
+    if (receiveScan(wait, data)) {
+      m_last_scan = std::chrono::steady_clock::now();
+      const bool connected = processScan(data, m_last_drain);
+      m_last_drain = std::chrono::steady_clock::now();
+      return connected;
+    }
   } catch (const sick::runtime_error &e) {
-    reportFailure("Error during requesting sensor persistent config: %s",
-                  e.what());
+    reportFailure("An error occured %s", e.what());
+    return true;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_last_scan < std::chrono::milliseconds(timeout)) {
+    return true;
+  }
+  m_last_scan = now;
+  return handleReceiveTimeout();
+}
+
+bool SickSafetyScanner::handleReceiveTimeout() {
+  if (m_awaiting_cached_stream) {
+    LOG_INFO("Sensor is not streaming with the cached settings. Updating "
+             "device config.");
+    return !requestConfiguration(true, false);
+  } else if (++m_consecutive_timeouts >= get_reconnect_after_timeouts()) {
+    LOG_WARNING("No sensor data received in %d consecutive attempts. "
+                "Reconnecting.",
+                m_consecutive_timeouts);
+    disconnect();
+    return false;
+  } else {
+    LOG_WARNING("Timeout while waiting to receive sensor data (UDP)");
+  }
+  return true;
+}
+
+bool SickSafetyScanner::connect(bool query_identity) {
+  try {
+    const sick::types::ip_address_t sensor_ip{
+        boost::asio::ip::address_v4::from_string(get_sensor_ip())};
+    m_comm_settings.host_ip =
+        sick::types::ip_address_t::address_v4::from_string(get_host_ip());
+    m_comm_settings.host_udp_port = get_host_udp_port();
+    m_host_udp_port = get_host_udp_port();
+    m_direct_decoder_active = get_direct_decoder_active() || m_reactor_mode;
+    if (m_direct_decoder_active) {
+      if (!m_datagram_receiver.open(get_host_udp_port())) {
+        LOG_ERROR("Could not open UDP port %d for the direct decoder",
+                  get_host_udp_port());
+        return false;
+      }
+      // The sensor streams to the socket of the direct decoder. The library
+      // binds an arbitrary port which stays unused.
+      m_host_udp_port = m_datagram_receiver.port();
+      m_comm_settings.host_udp_port = 0;
+      if (get_socket_receive_buffer() > 0) {
+        const int size = m_datagram_receiver.setReceiveBufferSize(
+            get_socket_receive_buffer());
+        if (size < get_socket_receive_buffer()) {
+          LOG_WARNING("Requested a socket receive buffer of %d bytes, got %d. "
+                      "Raise net.core.rmem_max or grant CAP_NET_ADMIN.",
+                      get_socket_receive_buffer(), size);
+        }
+        show("socket.receive_buffer", size);
+      }
+      if (!get_datagram_capture_path().empty() &&
+          !m_datagram_capture.is_open()) {
+        m_datagram_capture.open(get_datagram_capture_path(),
+                                std::ios::binary | std::ios::app);
+      }
+    }
+    if (!m_direct_decoder_active && get_socket_receive_buffer() > 0) {
+      LOG_WARNING("socket_receive_buffer only applies to the direct decoder");
+    }
+    const int tcp_port = get_tcp_port();
+    const sick::datastructure::CommSettings comm_settings = m_comm_settings;
+    const bool read_config = query_identity && get_use_persistent_config();
+    startRequest(SensorRequest::kConnect, [=]() {
+      return ConnectSensor(sensor_ip, tcp_port, comm_settings, query_identity,
+                           read_config);
+    });
+  } catch (const std::exception &e) {
+    LOG_ERROR("An unexpected error occured: %s", e.what());
+    m_datagram_receiver.close();
+    return false;
+  }
+  return true;
+}
+
+void SickSafetyScanner::disconnect() {
+  m_scanner.reset();
+  m_datagram_receiver.close();
+  m_consecutive_timeouts = 0;
+  scheduleReconnect();
+}
+
+void SickSafetyScanner::scheduleReconnect() {
+  const double backoff_min = std::max(get_reconnect_backoff_min(), 0.0);
+  const double backoff_max = std::max(get_reconnect_backoff_max(), backoff_min);
+  m_reconnect_backoff =
+      std::min(std::max(2.0 * m_reconnect_backoff, backoff_min), backoff_max);
+  m_next_reconnect =
+      std::chrono::steady_clock::now() +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(m_reconnect_backoff));
+}
+
+void SickSafetyScanner::reconnect() {
+  // A blocking codelet only delays its own thread by waiting here. The wait is
+  // sliced to keep stopping the node responsive. In reactor mode the next
+  // periodic tick tries again.
+  const auto now = std::chrono::steady_clock::now();
+  if (now < m_next_reconnect) {
+    if (!m_reactor_mode) {
+      std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(
+          m_next_reconnect - now, kWaitSlice));
+    }
+    return;
+  }
+
+  LOG_INFO("Connecting to SICK safety scanner at %s",
+           get_sensor_ip().c_str());
+  resetDevice();
+  const bool cached = loadCachedDevice();
+  if (cached) {
+    LOG_INFO("Using cached type code and configuration of device %u. They "
+             "are validated with the first received scan.",
+             m_serial_number);
+  }
+  if (!connect(!cached)) {
+    scheduleReconnect();
+    LOG_WARNING("Next connection attempt in %.1f seconds", m_reconnect_backoff);
+  }
+}
+
+void SickSafetyScanner::startRequest(SensorRequest kind,
+                                     std::function<SensorReply()> request) {
+  // Requests are rare, so each runs on a thread of its own. The thread is
+  // detached: stop() does not wait for the sensor, a request in flight
+  // finishes in the background and then releases the connection it shares.
+  std::promise<SensorReply> promise;
+  m_reply = promise.get_future();
+  m_request = kind;
+  std::thread(
+      [](std::function<SensorReply()> request,
+         std::promise<SensorReply> promise) { promise.set_value(request()); },
+      std::move(request), std::move(promise))
+      .detach();
+}
+
+bool SickSafetyScanner::collectReply() {
+  const auto wait =
+      m_reactor_mode ? std::chrono::milliseconds(0) : kWaitSlice;
+  if (m_reply.wait_for(wait) != std::future_status::ready) {
+    return false;
+  }
+  SensorReply reply = m_reply.get();
+  const SensorRequest request = m_request;
+  m_request = SensorRequest::kNone;
+  // Nothing has been received while waiting for the reply, so the receive
+  // timeout starts again.
+  m_last_scan = std::chrono::steady_clock::now();
+  m_last_drain = m_last_scan;
+
+  switch (request) {
+  case SensorRequest::kConnect:
+    return initializeDevice(reply);
+  case SensorRequest::kIdentify:
+    return finishIdentification(reply);
+  case SensorRequest::kConfigure:
+    return finishConfiguration(reply);
+  case SensorRequest::kFindMe:
+    if (!reply.ok) {
+      reportFailure("%s", reply.error.c_str());
+    }
+    return true;
+  case SensorRequest::kNone:
+    break;
   }
+  return true;
+}
+
+void SickSafetyScanner::resetDevice() {
+  m_device_configured = false;
+  m_identity_validated = false;
+  m_awaiting_cached_stream = false;
+  m_consecutive_timeouts = 0;
+  m_last_scan = std::chrono::steady_clock::now();
+  m_last_drain = m_last_scan;
+}
 
-  set_channel(config_data.getChannel());
-  set_channel_enabled(config_data.getEnabled());
+bool SickSafetyScanner::initializeDevice(SensorReply &reply) {
+  if (!reply.ok) {
+    LOG_ERROR("%s", reply.error.c_str());
+    m_datagram_receiver.close();
+    scheduleReconnect();
+    LOG_WARNING("Next connection attempt in %.1f seconds", m_reconnect_backoff);
+    return false;
+  }
+  m_scanner = std::move(reply.scanner);
+  if (reply.has_type_code) {
+    applyTypeCode(reply.type_code);
+  }
+  if (reply.has_config_data) {
+    applyConfigData(reply.config_data);
+  }
+  m_reconnect_backoff = 0.0;
+  return true;
+}
 
-  set_angle_start(config_data.getStartAngle());
-  set_angle_end(config_data.getEndAngle());
-  set_angle_offset(0.0f);
+bool SickSafetyScanner::validateDeviceIdentity(
+    const sick::datastructure::Data &data) {
+  if (data.getDataHeaderPtr()->isEmpty()) {
+    return true;
+  }
+  m_identity_validated = true;
 
+  const uint32_t serial_number =
+      data.getDataHeaderPtr()->getSerialNumberOfDevice();
+  if (serial_number == m_serial_number) {
+    return true;
+  }
+  if (m_serial_number != 0) {
+    LOG_WARNING("Cached identity belongs to device %u, but device %u is "
+                "connected. Requesting type code and configuration.",
+                m_serial_number, serial_number);
+    m_requested_serial = serial_number;
+    const auto scanner = m_scanner;
+    const bool read_config = get_use_persistent_config();
+    startRequest(SensorRequest::kIdentify, [scanner, read_config]() {
+      SensorReply reply;
+      QueryIdentity(*scanner, read_config, reply);
+      return reply;
+    });
+    return false;
+  }
+  m_serial_number = serial_number;
+  // The device was configured before its serial number was known.
+  if (m_device_configured) {
+    m_device_cache.finishConfiguration(m_serial_number, ToJson(m_prev_params));
+  } else {
+    m_device_cache.beginConfiguration(m_serial_number);
+  }
+  storeDeviceCache();
+  return true;
+}
+
+bool SickSafetyScanner::finishIdentification(const SensorReply &reply) {
+  if (!reply.ok) {
+    LOG_ERROR("%s", reply.error.c_str());
+    disconnect();
+    return false;
+  }
+  applyTypeCode(reply.type_code);
+  if (reply.has_config_data) {
+    applyConfigData(reply.config_data);
+  }
+  m_serial_number = m_requested_serial;
+  m_device_configured = false;
+  m_device_cache.beginConfiguration(m_serial_number);
+  storeDeviceCache();
+  return true;
+}
+
+void SickSafetyScanner::loadDeviceCache() {
+  m_device_cache = DeviceCache();
+  if (!get_device_cache_path().empty() &&
+      !m_device_cache.load(get_device_cache_path())) {
+    LOG_WARNING("Ignoring invalid device cache '%s'",
+                get_device_cache_path().c_str());
+  }
+}
+
+bool SickSafetyScanner::loadCachedDevice() {
+  const uint32_t serial_number = m_device_cache.serialNumber(get_sensor_ip());
+  const nlohmann::json *device =
+      serial_number != 0 ? m_device_cache.findDevice(serial_number) : nullptr;
+  if (device == nullptr || !device->contains("max_range") ||
+      !device->contains("interface_type")) {
+    return false;
+  }
+  if (get_use_persistent_config() && !device->contains("persistent_config")) {
+    return false;
+  }
+
+  try {
+    m_range_min = 0.1;
+    m_range_max = device->at("max_range").get<float>();
+    m_e_interface_type = device->at("interface_type").get<uint8_t>();
+    if (get_use_persistent_config()) {
+      m_persistent_config =
+          ParseChannelParams(device->at("persistent_config"), m_persistent_config);
+      applyPersistentConfig(m_persistent_config);
+    }
+  } catch (const std::exception &e) {
+    LOG_WARNING("Ignoring invalid device cache entry: %s", e.what());
+    return false;
+  }
+  m_serial_number = serial_number;
+  m_awaiting_cached_stream =
+      get_host_udp_port() != 0 &&
+      m_device_cache.isStreaming(serial_number, ToJson(currentParams()));
+  return true;
+}
+
+void SickSafetyScanner::storeDeviceCache() {
+  if (get_device_cache_path().empty() || m_serial_number == 0) {
+    return;
+  }
+  nlohmann::json &device = m_device_cache.device(m_serial_number);
+  device["max_range"] = m_range_max;
+  device["interface_type"] = m_e_interface_type;
+  if (get_use_persistent_config()) {
+    device["persistent_config"] = ToJson(m_persistent_config);
+  }
+  m_device_cache.setSerialNumber(get_sensor_ip(), m_serial_number);
+  if (!m_device_cache.save(get_device_cache_path())) {
+    LOG_WARNING("Could not write device cache '%s'",
+                get_device_cache_path().c_str());
+  }
+}
+
+bool SickSafetyScanner::requestConfiguration(bool primary, bool additional) {
+  m_configure_primary = primary;
+  m_configure_additional = additional;
+  std::vector<sick::datastructure::CommSettings> settings;
+  if (primary) {
+    m_awaiting_cached_stream = false;
+    m_device_configured = false;
+    if (m_serial_number != 0) {
+      m_device_cache.beginConfiguration(m_serial_number);
+      storeDeviceCache();
+    }
+    settings.push_back(toCommSettings(m_prev_params));
+  }
+  m_requested_channels.clear();
+  if (additional) {
+    const std::vector<int> removed_channels = parseAdditionalChannels();
+    for (const auto &channel : m_requested_channels) {
+      settings.push_back(toCommSettings(channel.params));
+    }
+    // Stop streaming of channels which have been removed from the list
+    for (const int removed_channel : removed_channels) {
+      ConfigurationParams disabled = m_prev_params;
+      disabled.channel = removed_channel;
+      disabled.channel_enabled = false;
+      settings.push_back(toCommSettings(disabled));
+    }
+  }
+  if (settings.empty()) {
+    finishConfiguration(SensorReply());
+    return false;
+  }
+
+  const auto scanner = m_scanner;
+  startRequest(SensorRequest::kConfigure, [scanner, settings]() {
+    return ChangeSensorSettings(scanner, settings);
+  });
+  return true;
+}
+
+bool SickSafetyScanner::finishConfiguration(const SensorReply &reply) {
+  if (!reply.error.empty()) {
+    LOG_ERROR("%s", reply.error.c_str());
+  }
+  std::size_t index = 0;
+  const auto applied = [&reply, &index]() {
+    const std::size_t i = index++;
+    return i < reply.settings_applied.size() && reply.settings_applied[i];
+  };
+
+  if (m_configure_primary) {
+    if (!applied()) {
+      disconnect();
+      return false;
+    }
+    m_device_configured = true;
+    if (m_serial_number != 0) {
+      m_device_cache.finishConfiguration(m_serial_number,
+                                         ToJson(m_prev_params));
+      storeDeviceCache();
+    }
+  }
+
+  if (m_configure_additional) {
+    m_channels.resize(1);
+    for (auto &channel : m_requested_channels) {
+      // A channel which could not be configured does not stream and is not
+      // published. It is tried again once the parameters change or the
+      // sensor has been reconnected.
+      if (!applied()) {
+        LOG_ERROR("Channel %d is skipped, it could not be configured.",
+                  channel.params.channel);
+        continue;
+      }
+      m_channels.push_back(std::move(channel));
+    }
+    m_requested_channels.clear();
+  }
+  return true;
+}
+
+void SickSafetyScanner::stop() {
+  LOG_INFO("Stopping SickSafetyScanner node");
+  // A request in flight is not waited for, see startRequest().
+  m_reply = std::future<SensorReply>();
+  m_request = SensorRequest::kNone;
+  m_scanner.reset();
+  m_datagram_receiver.close();
+  m_shared_ring.close();
+  m_datagram_capture.close();
+}
+
+void SickSafetyScanner::applyTypeCode(
+    const sick::datastructure::TypeCode &type_code) {
+  m_range_min = 0.1;
+  m_range_max = type_code.getMaxRange();
+  m_e_interface_type = type_code.getInterfaceType();
+}
+
+void SickSafetyScanner::applyConfigData(
+    const sick::datastructure::ConfigData &config_data) {
   auto features = config_data.getFeatures();
   using sick::SensorDataFeatures::isFlagSet;
 
-  set_application_io_data(
-      isFlagSet(features, sick::SensorDataFeatures::APPLICATION_DATA));
-  set_measurement_data(
-      isFlagSet(features, sick::SensorDataFeatures::MEASUREMENT_DATA));
-  set_derived_settings(
-      isFlagSet(features, sick::SensorDataFeatures::DERIVED_SETTINGS));
-  set_intrusion_data(
-      isFlagSet(features, sick::SensorDataFeatures::INTRUSION_DATA));
-  set_general_system_state(
-      isFlagSet(features, sick::SensorDataFeatures::GENERAL_SYSTEM_STATE));
+  m_persistent_config.channel = config_data.getChannel();
+  m_persistent_config.channel_enabled = config_data.getEnabled();
+
+  m_persistent_config.angle_start = config_data.getStartAngle();
+  m_persistent_config.angle_end = config_data.getEndAngle();
+  m_persistent_config.angle_offset = 0.0f;
+
+  m_persistent_config.application_io_data =
+      isFlagSet(features, sick::SensorDataFeatures::APPLICATION_DATA);
+  m_persistent_config.measurement_data =
+      isFlagSet(features, sick::SensorDataFeatures::MEASUREMENT_DATA);
+  m_persistent_config.derived_settings =
+      isFlagSet(features, sick::SensorDataFeatures::DERIVED_SETTINGS);
+  m_persistent_config.intrusion_data =
+      isFlagSet(features, sick::SensorDataFeatures::INTRUSION_DATA);
+  m_persistent_config.general_system_state =
+      isFlagSet(features, sick::SensorDataFeatures::GENERAL_SYSTEM_STATE);
+
+  m_persistent_config.publishing_frequency_factor =
+      config_data.getPublishingFrequency();
+
+  applyPersistentConfig(m_persistent_config);
+}
+
+void SickSafetyScanner::applyPersistentConfig(
+    const ConfigurationParams &params) {
+  set_channel(params.channel);
+  set_channel_enabled(params.channel_enabled);
+
+  set_angle_start(params.angle_start);
+  set_angle_end(params.angle_end);
+  set_angle_offset(params.angle_offset);
+
+  set_application_io_data(params.application_io_data);
+  set_measurement_data(params.measurement_data);
+  set_derived_settings(params.derived_settings);
+  set_intrusion_data(params.intrusion_data);
+  set_general_system_state(params.general_system_state);
+
+  set_publishing_frequency_factor(params.publishing_frequency_factor);
+}
 
-  set_publishing_frequency_factor(config_data.getPublishingFrequency());
+ConfigurationParams SickSafetyScanner::currentParams() {
+  ConfigurationParams params;
+  params.channel = get_channel();
+  params.channel_enabled = get_channel_enabled();
+  params.angle_start = get_angle_start();
+  params.angle_offset = get_angle_offset();
+  params.angle_end = get_angle_end();
+  params.application_io_data = get_application_io_data();
+  params.derived_settings = get_derived_settings();
+  params.general_system_state = get_general_system_state();
+  params.intrusion_data = get_intrusion_data();
+  params.measurement_data = get_measurement_data();
+  params.publishing_frequency_factor = get_publishing_frequency_factor();
+  return params;
 }
 
 bool SickSafetyScanner::isParamSetDirty() {
-  if (get_channel() != m_prev_params.channel ||
-      get_channel_enabled() != m_prev_params.channel_enabled ||
-      get_angle_offset() != m_prev_params.angle_offset ||
-      get_angle_start() != m_prev_params.angle_start ||
-      get_angle_end() != m_prev_params.angle_end ||
-      get_general_system_state() != m_prev_params.general_system_state ||
-      get_derived_settings() != m_prev_params.derived_settings ||
-      get_measurement_data() != m_prev_params.measurement_data ||
-      get_intrusion_data() != m_prev_params.intrusion_data ||
-      get_application_io_data() != m_prev_params.application_io_data ||
-      get_publishing_frequency_factor() !=
-          m_prev_params.publishing_frequency_factor) {
-    return true;
+  return !(currentParams() == m_prev_params);
+}
+
+void SickSafetyScanner::updatePrevParams() { m_prev_params = currentParams(); }
+
+void SickSafetyScanner::updateAdaptiveRate(double publish_latency,
+                                           double receive_wait) {
+  m_load_monitor.configure(get_adaptive_latency_budget() * 1e-3, 0.1, 1e-3);
+  m_load_monitor.addSample(publish_latency, receive_wait);
+  for (auto &channel : m_channels) {
+    channel.flatscan_decimator.configure(get_flatscan_max_decimation());
+    channel.flatscan_decimator.update(m_load_monitor);
+  }
+
+  show("publish_latency", m_load_monitor.latency() * 1e3);
+  show("receive_backlog", m_load_monitor.backlog());
+  show("flatscan_decimation", m_channels.front().flatscan_decimator.decimation());
+}
+
+std::vector<int> SickSafetyScanner::parseAdditionalChannels() {
+  const nlohmann::json entries = get_additional_channels();
+  m_prev_additional_channels = entries;
+
+  if (!entries.is_array()) {
+    LOG_ERROR("Parameter additional_channels has to be a list of objects.");
+    return {};
+  }
+  if (entries.size() > kMaxAdditionalChannels) {
+    LOG_WARNING("Only the first %zu entries of additional_channels are used.",
+                kMaxAdditionalChannels);
+  }
+
+  const std::size_t n_entries = std::min(entries.size(), kMaxAdditionalChannels);
+  for (std::size_t i = 0; i < n_entries; i++) {
+    const nlohmann::json &entry = entries[i];
+    if (!entry.is_object() || !entry.contains("channel")) {
+      LOG_ERROR("Entry %zu of additional_channels has no channel number.", i);
+      continue;
+    }
+
+    MeasurementChannel channel;
+    try {
+      channel.params = ParseChannelParams(entry, m_prev_params);
+      channel.flatscan_pub_active =
+          entry.value("flatscan_pub_active", get_flatscan_pub_active());
+      channel.safety_pub_active =
+          entry.value("safety_pub_active", get_safety_pub_active());
+      channel.outputpath_pub_active =
+          entry.value("outputpath_pub_active", get_outputpath_pub_active());
+    } catch (const nlohmann::json::exception &e) {
+      LOG_ERROR("Entry %zu of additional_channels is skipped, it has a value "
+                "of the wrong type: %s",
+                i, e.what());
+      continue;
+    }
+    if (channel.params.channel == m_prev_params.channel) {
+      LOG_ERROR("Channel %d is already used as primary channel.",
+                channel.params.channel);
+      continue;
+    }
+
+    switch (i) {
+    case 0:
+      channel.tx_flatscan = &tx_flatscan_1();
+      channel.tx_safety_scan = &tx_safety_scan_1();
+      channel.tx_output_path = &tx_output_path_1();
+      break;
+    case 1:
+      channel.tx_flatscan = &tx_flatscan_2();
+      channel.tx_safety_scan = &tx_safety_scan_2();
+      channel.tx_output_path = &tx_output_path_2();
+      break;
+    default:
+      channel.tx_flatscan = &tx_flatscan_3();
+      channel.tx_safety_scan = &tx_safety_scan_3();
+      channel.tx_output_path = &tx_output_path_3();
+      break;
+    }
+
+    m_requested_channels.push_back(channel);
   }
-  return false;
+
+  std::vector<int> removed_channels;
+  for (std::size_t i = 1; i < m_channels.size(); i++) {
+    const int previous_channel = m_channels[i].params.channel;
+    const bool still_used = std::any_of(
+        m_requested_channels.begin(), m_requested_channels.end(),
+        [previous_channel](const MeasurementChannel &channel) {
+          return channel.params.channel == previous_channel;
+        });
+    if (!still_used) {
+      removed_channels.push_back(previous_channel);
+    }
+  }
+  return removed_channels;
 }
 
-void SickSafetyScanner::updatePrevParams() {
-  m_prev_params.channel = get_channel();
-  m_prev_params.channel_enabled = get_channel_enabled();
-  m_prev_params.angle_start = get_angle_start();
-  m_prev_params.angle_offset = get_angle_offset();
-  m_prev_params.angle_end = get_angle_end();
-  m_prev_params.application_io_data = get_application_io_data();
-  m_prev_params.derived_settings = get_derived_settings();
-  m_prev_params.general_system_state = get_general_system_state();
-  m_prev_params.intrusion_data = get_intrusion_data();
-  m_prev_params.measurement_data = get_measurement_data();
-  m_prev_params.publishing_frequency_factor = get_publishing_frequency_factor();
+MeasurementChannel &
+SickSafetyScanner::channelOf(const sick::datastructure::Data &data) {
+  if (m_channels.size() > 1 && !data.getDataHeaderPtr()->isEmpty()) {
+    const int channel_number = data.getDataHeaderPtr()->getChannelNumber();
+    for (auto &channel : m_channels) {
+      if (channel.params.channel == channel_number) {
+        return channel;
+      }
+    }
+  }
+  return m_channels.front();
 }
 
-void SickSafetyScanner::updateDeviceConfig() {
-  LOG_INFO("Updating device config. Host_ip and host_udp_port are only "
-           "considered on first initialization.");
+sick::datastructure::CommSettings
+SickSafetyScanner::toCommSettings(const ConfigurationParams &params) {
+  LOG_INFO("Updating device config of channel %d. Host_ip and host_udp_port "
+           "are only considered on first initialization.",
+           params.channel);
   sick::types::SensorFeatures features{sick::SensorDataFeatures::NONE};
   features = sick::SensorDataFeatures::toFeatureFlags(
-      get_general_system_state(), get_derived_settings(),
-      get_measurement_data(), get_intrusion_data(), get_application_io_data());
+      params.general_system_state, params.derived_settings,
+      params.measurement_data, params.intrusion_data,
+      params.application_io_data);
 
   sick::datastructure::CommSettings settings;
   settings.host_ip =
       sick::types::ip_address_t::address_v4::from_string(get_host_ip());
-  settings.host_udp_port = get_host_udp_port();
+  settings.host_udp_port = m_host_udp_port;
   settings.features = features;
-  settings.channel = get_channel();
+  settings.channel = params.channel;
 
-  if (std::fabs(get_angle_start() - get_angle_end()) <=
+  if (std::fabs(params.angle_start - params.angle_end) <=
       std::numeric_limits<float>::epsilon()) {
     settings.start_angle = RadToDeg(0.0f);
     settings.end_angle = RadToDeg(0.0f);
   } else {
-    settings.start_angle = RadToDeg(get_angle_start()) - get_angle_offset();
-    settings.end_angle = RadToDeg(get_angle_end()) - get_angle_offset();
+    settings.start_angle = RadToDeg(params.angle_start) - params.angle_offset;
+    settings.end_angle = RadToDeg(params.angle_end) - params.angle_offset;
   }
 
-  settings.publishing_frequency = get_publishing_frequency_factor();
-  settings.enabled = get_channel_enabled();
+  settings.publishing_frequency = params.publishing_frequency_factor;
+  settings.enabled = params.channel_enabled;
   settings.e_interface_type = m_e_interface_type;
+  return settings;
+}
 
-  try {
-    m_scanner->changeSensorSettings(settings);
-  } catch (const sick::runtime_error &e) {
-    reportFailure("Error during updating sensor settings: %s", e.what());
+void SickSafetyScanner::extractScanBeams(const sick::datastructure::Data &data,
+                                         const MeasurementChannel &channel) {
+  if (m_direct_decoder_active) {
+    DecodeScanBeams(m_datagram_receiver.payload(), data,
+                    channel.params.angle_offset, m_scan_beams);
+  } else {
+    ExtractScanBeams(*data.getMeasurementDataPtr(),
+                     channel.params.angle_offset, m_scan_beams);
+  }
+}
+
+void SickSafetyScanner::updateSharedMemory() {
+  const std::string path = get_shm_path();
+  if (path == m_shared_ring_path) {
+    return;
+  }
+  m_shared_ring_path = path;
+  m_shared_ring.close();
+  if (path.empty()) {
+    return;
+  }
+  if (get_shm_slot_count() <= 0 || get_shm_max_beams() <= 0) {
+    reportFailure("shm_slot_count and shm_max_beams have to be positive");
+    return;
+  }
+  if (!m_shared_ring.open(path, get_shm_slot_count(), get_shm_max_beams())) {
+    LOG_ERROR("Could not create shared-memory scan ring '%s': %s",
+              path.c_str(), m_shared_ring.error().c_str());
+    return;
+  }
+  LOG_INFO("Writing scans into shared-memory ring '%s'", path.c_str());
+}
+
+void SickSafetyScanner::publishSharedMemory(
+    const sick::datastructure::Data &data, const MeasurementChannel &channel) {
+  if (data.getDerivedValuesPtr()->isEmpty() || m_scan_beams.size() == 0) {
+    return;
+  }
+  const auto derived_values = data.getDerivedValuesPtr();
+  const auto data_header = data.getDataHeaderPtr();
+  const std::size_t n_scan_points =
+      std::min<std::size_t>(m_scan_beams.size(), m_shared_ring.maxBeams());
+  const float angle_offset = channel.params.angle_offset;
+
+  float *angles;
+  uint16_t *distances;
+  uint8_t *reflectivities;
+  uint8_t *status;
+  SharedScanRecord *record =
+      m_shared_ring.beginWrite(angles, distances, reflectivities, status);
+  record->serial_number = data_header->getSerialNumberOfDevice();
+  record->scan_number = data_header->getScanNumber();
+  record->sequence_number = data_header->getSequenceNumber();
+  record->channel = data_header->getChannelNumber();
+  record->start_angle =
+      DegToRad(derived_values->getStartAngle() + angle_offset);
+  record->angular_resolution =
+      DegToRad(derived_values->getAngularBeamResolution());
+  record->scan_time = derived_values->getScanTime();
+  record->multiplication_factor = derived_values->getMultiplicationFactor();
+  record->number_of_beams = n_scan_points;
+
+  std::copy_n(m_scan_beams.angles.begin(), n_scan_points, angles);
+  std::copy_n(m_scan_beams.distances.begin(), n_scan_points, distances);
+  std::copy_n(m_scan_beams.reflectivities.begin(), n_scan_points,
+              reflectivities);
+  std::copy_n(m_scan_beams.status.begin(), n_scan_points, status);
+  m_shared_ring.commit();
+}
+
+bool SickSafetyScanner::isVisualizationDue(
+    const MeasurementChannel &channel) const {
+  if (!get_viz_pub_active() || &channel != &m_channels.front()) {
+    return false;
+  }
+  const double max_rate = get_viz_max_rate();
+  return max_rate <= 0.0 ||
+         std::chrono::steady_clock::now() - m_last_viz_publish >=
+             std::chrono::duration<double>(1.0 / max_rate);
+}
+
+void SickSafetyScanner::publishVisualization(
+    const sick::datastructure::Data &data, const MeasurementChannel &channel) {
+  const std::size_t n_scan_points = m_scan_beams.size();
+  if (data.getDerivedValuesPtr()->isEmpty() || n_scan_points == 0) {
+    return;
+  }
+  const auto multiplication_factor =
+      data.getDerivedValuesPtr()->getMultiplicationFactor();
+
+  m_viz_binning.configure(get_viz_bins());
+  m_viz_binning.begin(m_scan_beams.angles.front(),
+                      m_scan_beams.angles[n_scan_points - 1]);
+  for (std::size_t i = 0; i < n_scan_points; i++) {
+    const float range = static_cast<float>(m_scan_beams.distances[i] *
+                                           multiplication_factor) *
+                        1e-3; //  mm -> m
+    if (range < m_range_min) {
+      continue;
+    }
+    m_viz_binning.add(m_scan_beams.angles[i], range, m_scan_beams.status[i]);
+  }
+  m_viz_binning.finish();
+
+  const auto &bin_angles = m_viz_binning.angles();
+  const auto &bin_ranges = m_viz_binning.ranges();
+  auto flat_scan_proto = tx_flatscan_viz().initProto();
+  flat_scan_proto.setInvalidRangeThreshold(m_range_min);
+  flat_scan_proto.setOutOfRangeThreshold(m_range_max);
+  auto ranges = flat_scan_proto.initRanges(bin_ranges.size());
+  auto angles = flat_scan_proto.initAngles(bin_angles.size());
+  for (std::size_t i = 0; i < bin_ranges.size(); i++) {
+    ranges.set(i, bin_ranges[i]);
+    angles.set(i, bin_angles[i]);
+  }
+  tx_flatscan_viz().publish();
+  m_last_viz_publish = std::chrono::steady_clock::now();
+}
+
+void SickSafetyScanner::appendToBatch(const sick::datastructure::Data &data,
+                                      MeasurementChannel &channel) {
+  const std::size_t n_scan_points = m_scan_beams.size();
+  if (data.getDerivedValuesPtr()->isEmpty() || n_scan_points == 0) {
+    return;
+  }
+  const auto derived_values = data.getDerivedValuesPtr();
+  const auto data_header = data.getDataHeaderPtr();
+
+  ScanBatchLayout layout;
+  layout.serial_number = data_header->getSerialNumberOfDevice();
+  layout.channel = data_header->getChannelNumber();
+  layout.multiplication_factor = derived_values->getMultiplicationFactor();
+  layout.scan_time = derived_values->getScanTime();
+  layout.start_angle =
+      DegToRad(derived_values->getStartAngle() + channel.params.angle_offset);
+  layout.angular_resolution =
+      DegToRad(derived_values->getAngularBeamResolution());
+  layout.number_of_beams = n_scan_points;
+
+  ScanBatchEntry entry;
+  entry.scan_number = data_header->getScanNumber();
+  entry.sequence_number = data_header->getSequenceNumber();
+  entry.timestamp_date = data_header->getTimestampDate();
+  entry.timestamp_time = data_header->getTimestampTime();
+  entry.acqtime = node()->clock()->timestamp();
+
+  ScanBatch &batch = channel.batch;
+  batch.configure(std::max(get_batch_size(), 1),
+                  static_cast<int64_t>(get_batch_latency() * 1e6));
+  if (!batch.accepts(layout)) {
+    publishBatch(batch);
+  }
+
+  uint16_t *distances;
+  uint8_t *reflectivities;
+  uint8_t *status;
+  batch.append(layout, entry, distances, reflectivities, status);
+  std::copy_n(m_scan_beams.distances.begin(), n_scan_points, distances);
+  std::copy_n(m_scan_beams.reflectivities.begin(), n_scan_points,
+              reflectivities);
+  std::copy_n(m_scan_beams.status.begin(), n_scan_points, status);
+
+  if (batch.due(entry.acqtime)) {
+    publishBatch(batch);
+  }
+}
+
+void SickSafetyScanner::publishDueBatches() {
+  const int64_t now = node()->clock()->timestamp();
+  const bool active = get_batch_pub_active();
+  for (auto &channel : m_channels) {
+    if (!active) {
+      channel.batch.clear();
+    } else if (channel.batch.due(now)) {
+      publishBatch(channel.batch);
+    }
   }
 }
 
+void SickSafetyScanner::publishBatch(ScanBatch &batch) {
+  if (batch.empty()) {
+    return;
+  }
+  const ScanBatchLayout &layout = batch.layout();
+  const auto &entries = batch.entries();
+  const std::size_t n_scans = entries.size();
+  const std::size_t n_beams = batch.distances().size();
+
+  auto batch_proto = tx_safety_scan_batch().initProto();
+  batch_proto.setSerialNumberOfDevice(layout.serial_number);
+  batch_proto.setChannelNumber(layout.channel);
+  batch_proto.setMultiplicationFactor(layout.multiplication_factor);
+  batch_proto.setScanTime(layout.scan_time);
+  batch_proto.setStartAngle(layout.start_angle);
+  batch_proto.setAngularBeamResolution(layout.angular_resolution);
+  batch_proto.setNumberOfBeams(layout.number_of_beams);
+
+  auto scan_numbers = batch_proto.initScanNumber(n_scans);
+  auto sequence_numbers = batch_proto.initSequenceNumber(n_scans);
+  auto timestamp_dates = batch_proto.initTimestampDate(n_scans);
+  auto timestamp_times = batch_proto.initTimestampTime(n_scans);
+  auto acqtimes = batch_proto.initAcqtime(n_scans);
+  for (std::size_t i = 0; i < n_scans; i++) {
+    scan_numbers.set(i, entries[i].scan_number);
+    sequence_numbers.set(i, entries[i].sequence_number);
+    timestamp_dates.set(i, entries[i].timestamp_date);
+    timestamp_times.set(i, entries[i].timestamp_time);
+    acqtimes.set(i, entries[i].acqtime);
+  }
+
+  auto distances = batch_proto.initDistance(n_beams);
+  auto reflectivities = batch_proto.initReflectivity(n_beams);
+  auto status = batch_proto.initStatus(n_beams);
+  const auto &batch_distances = batch.distances();
+  const auto &batch_reflectivities = batch.reflectivities();
+  const auto &batch_status = batch.status();
+  for (std::size_t i = 0; i < n_beams; i++) {
+    distances.set(i, batch_distances[i]);
+    reflectivities.set(i, batch_reflectivities[i]);
+    status.set(i, batch_status[i]);
+  }
+
+  tx_safety_scan_batch().publish(entries.front().acqtime);
+  batch.clear();
+}
+
 void SickSafetyScanner::publishSafetyScan(
-    const sick::datastructure::Data &data) {
-  auto safety_scan_proto = tx_safety_scan().initProto();
-  ToProto(data, safety_scan_proto, get_angle_offset());
-  tx_safety_scan().publish();
+    const sick::datastructure::Data &data, MeasurementChannel &channel) {
+  auto safety_scan_proto = channel.tx_safety_scan->initProto();
+  if (m_direct_decoder_active) {
+    DecodeSafetyScan(m_datagram_receiver.payload(), data, safety_scan_proto,
+                     channel.params.angle_offset);
+  } else {
+    ToProto(data, safety_scan_proto, channel.params.angle_offset);
+  }
+  channel.tx_safety_scan->publish();
 }
 
 void SickSafetyScanner::publishFlatScanProto(
-    const sick::datastructure::Data &data) {
-  if (data.getDerivedValuesPtr()->isEmpty() ||
-      data.getMeasurementDataPtr()->isEmpty()) {
+    const sick::datastructure::Data &data, MeasurementChannel &channel) {
+  if (data.getDerivedValuesPtr()->isEmpty() || m_scan_beams.size() == 0) {
     LOG_WARNING("Publishing FlatScanProto is not possible when derived values "
                 "or measurement data is disabled in the sensor.");
     return;
   }
-  const std::size_t n_scan_points =
-      data.getMeasurementDataPtr()->getNumberOfBeams();
-  const std::vector<sick::datastructure::ScanPoint> scan_points =
-      data.getMeasurementDataPtr()->getScanPointsVector();
+  const std::size_t n_scan_points = m_scan_beams.size();
+  const auto multiplication_factor =
+      data.getDerivedValuesPtr()->getMultiplicationFactor();
 
-  auto flat_scan_proto = tx_flatscan().initProto();
+  // Beams with any of these status flags are published as invalid ranges
+  const bool drop_invalid = get_flatscan_drop_invalid();
+  const bool drop_glare = get_flatscan_drop_glare();
+  const bool drop_contamination = get_flatscan_drop_contamination();
+  const bool drop_contamination_warning =
+      get_flatscan_drop_contamination_warning();
+  const bool infinite_as_out_of_range =
+      get_flatscan_infinite_as_out_of_range();
+  const bool visibilities_active = get_flatscan_visibilities();
+  const float invalid_range = 0.0f;
+  const float out_of_range = m_range_max;
+
+  auto flat_scan_proto = channel.tx_flatscan->initProto();
   flat_scan_proto.setInvalidRangeThreshold(m_range_min);
   flat_scan_proto.setOutOfRangeThreshold(m_range_max);
-  flat_scan_proto.initRanges(n_scan_points);
-  flat_scan_proto.initAngles(n_scan_points);
-  // flat_scan_proto.initVisibilities(n_scan_points);
+  auto ranges = flat_scan_proto.initRanges(n_scan_points);
+  auto angles = flat_scan_proto.initAngles(n_scan_points);
+  auto visibilities =
+      flat_scan_proto.initVisibilities(visibilities_active ? n_scan_points : 0);
 
   for (std::size_t i = 0; i < n_scan_points; i++) {
-    const auto scan_point = scan_points[i];
+    const uint8_t status = m_scan_beams.status[i];
 
     // Ranges [meter]
-    float range = static_cast<float>(
-                      scan_point.getDistance() *
-                      data.getDerivedValuesPtr()->getMultiplicationFactor()) *
+    float range = static_cast<float>(m_scan_beams.distances[i] *
+                                     multiplication_factor) *
                   1e-3; //  mm -> m
-    flat_scan_proto.getRanges().set(i, range);
+    if ((drop_invalid && !(status & kBeamValid)) ||
+        (drop_glare && (status & kBeamGlare)) ||
+        (drop_contamination && (status & kBeamContamination)) ||
+        (drop_contamination_warning && (status & kBeamContaminationWarning))) {
+      range = invalid_range;
+    } else if (infinite_as_out_of_range && (status & kBeamInfinite)) {
+      range = out_of_range;
+    }
+    ranges.set(i, range);
 
     // Angles [radians]
-    float angle_rad = DegToRad(scan_point.getAngle() + get_angle_offset());
-    flat_scan_proto.getAngles().set(i, angle_rad);
+    angles.set(i, m_scan_beams.angles[i]);
 
-    // Visibility / Reflectivity
-    // flat_scan_proto.getVisibilities().set(
-    //     i, static_cast<float>(scan_point.getReflectivity()));
+    // Visibility / Reflectivity, normalized to [0, 1]
+    if (visibilities_active) {
+      visibilities.set(
+          i, static_cast<float>(m_scan_beams.reflectivities[i]) / 255.0f);
+    }
   }
-  tx_flatscan().publish();
+  channel.tx_flatscan->publish();
 }
 
 void SickSafetyScanner::publishOutputPath(
-    const sick::datastructure::Data &data) {
+    const sick::datastructure::Data &data, MeasurementChannel &channel) {
   auto app_data = data.getApplicationDataPtr();
   auto outputs = app_data->getOutputs();
 
@@ -279,24 +1370,24 @@ void SickSafetyScanner::publishOutputPath(
   auto monitoring_case_numbers = outputs.getMonitoringCaseVector();
   auto monitoring_case_number_flags = outputs.getMonitoringCaseFlagsVector();
 
-  auto outputpath_proto = tx_output_path().initProto();
+  auto outputpath_proto = channel.tx_output_path->initProto();
 
   if (monitoring_case_number_flags.at(0)) {
     outputpath_proto.setActiveMonitoringCase(monitoring_case_numbers.at(0));
   }
 
   std::size_t n_eval_count = eval_out.size();
-  outputpath_proto.initIsSafe(n_eval_count);
-  outputpath_proto.initIsValid(n_eval_count);
-  outputpath_proto.initStatus(n_eval_count);
+  auto is_safe = outputpath_proto.initIsSafe(n_eval_count);
+  auto is_valid = outputpath_proto.initIsValid(n_eval_count);
+  auto status = outputpath_proto.initStatus(n_eval_count);
 
   for (size_t i = 0; i < eval_out.size(); i++) {
-    outputpath_proto.getStatus().set(i, eval_out[i]);
-    outputpath_proto.getIsSafe().set(i, eval_out_is_safe[i]);
-    outputpath_proto.getIsValid().set(i, eval_out_valid[i]);
+    status.set(i, eval_out[i]);
+    is_safe.set(i, eval_out_is_safe[i]);
+    is_valid.set(i, eval_out_valid[i]);
   }
 
-  tx_output_path().publish();
+  channel.tx_output_path->publish();
 }
 
 } // namespace sick_safetyscanners
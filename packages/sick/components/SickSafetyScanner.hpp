@@ -33,17 +33,30 @@
 
 #pragma once
 
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "engine/alice/alice_codelet.hpp"
+#include "engine/gems/serialization/json.hpp"
 #include "messages/messages.hpp"
 #include "engine/core/byte.hpp"
 #include "messages/messages.hpp"
 
 #include "packages/sick/messages/safety_scan.hpp"
 #include "packages/sick/messages/commands.hpp"
+#include "packages/sick/messages/safety_scan_batch.hpp"
+#include "packages/sick/gems/adaptive_rate.hpp"
+#include "packages/sick/gems/device_cache.hpp"
+#include "packages/sick/gems/realtime.hpp"
+#include "packages/sick/gems/scan_batch.hpp"
+#include "packages/sick/gems/scan_binning.hpp"
+#include "packages/sick/gems/scan_datagram.hpp"
+#include "packages/sick/gems/shared_scan_ring.hpp"
 
 #include <sick_safetyscanners_base/SickSafetyscanners.h>
 
@@ -67,6 +80,60 @@ struct ConfigurationParams
     bool application_io_data{true};
 
     float publishing_frequency_factor{1.0f};
+
+    bool operator==(const ConfigurationParams &other) const
+    {
+        return channel == other.channel && channel_enabled == other.channel_enabled &&
+               angle_offset == other.angle_offset && angle_start == other.angle_start &&
+               angle_end == other.angle_end && general_system_state == other.general_system_state &&
+               derived_settings == other.derived_settings && measurement_data == other.measurement_data &&
+               intrusion_data == other.intrusion_data && application_io_data == other.application_io_data &&
+               publishing_frequency_factor == other.publishing_frequency_factor;
+    }
+};
+
+// A measurement channel of the sensor together with the outputs its scans are published on.
+struct MeasurementChannel
+{
+    ConfigurationParams params;
+
+    bool flatscan_pub_active{false};
+    bool safety_pub_active{true};
+    bool outputpath_pub_active{false};
+
+    isaac::alice::ProtoTx<FlatscanProto> *tx_flatscan{nullptr};
+    isaac::alice::ProtoTx<SafetyScanProto> *tx_safety_scan{nullptr};
+    isaac::alice::ProtoTx<OutputPathProto> *tx_output_path{nullptr};
+
+    AdaptiveDecimator flatscan_decimator;
+    // Scans of this channel waiting to be published on safety_scan_batch.
+    ScanBatch batch;
+};
+
+// Reply of the sensor to a COLA2 request. Requests run on a helper thread, since they block until
+// the sensor answers or the request times out.
+struct SensorReply
+{
+    bool ok{false};
+    std::string error;
+    // The connection opened by a connect request.
+    std::shared_ptr<sick::SyncSickSafetyScanner> scanner;
+    bool has_type_code{false};
+    sick::datastructure::TypeCode type_code;
+    bool has_config_data{false};
+    sick::datastructure::ConfigData config_data;
+    // Whether each of the requested settings has been applied, in the order of the request.
+    std::vector<bool> settings_applied;
+};
+
+// The kind of a COLA2 request in flight.
+enum class SensorRequest
+{
+    kNone,
+    kConnect,
+    kIdentify,
+    kConfigure,
+    kFindMe
 };
 
 class SickSafetyScanner : public isaac::alice::Codelet
@@ -91,6 +158,24 @@ public:
     // OutputPath channel.
     ISAAC_PROTO_TX(OutputPathProto, output_path);
 
+    // Reduced flatscan of the primary channel for remote visualization, see viz_pub_active.
+    ISAAC_PROTO_TX(FlatscanProto, flatscan_viz);
+
+    // Consecutive scans packed into one message with columnar beam data. Scans of all channels
+    // are published here; every message only contains scans of a single channel.
+    ISAAC_PROTO_TX(SafetyScanBatchProto, safety_scan_batch);
+
+    // Outputs of the entries in additional_channels, in the order of the list.
+    ISAAC_PROTO_TX(FlatscanProto, flatscan_1);
+    ISAAC_PROTO_TX(SafetyScanProto, safety_scan_1);
+    ISAAC_PROTO_TX(OutputPathProto, output_path_1);
+    ISAAC_PROTO_TX(FlatscanProto, flatscan_2);
+    ISAAC_PROTO_TX(SafetyScanProto, safety_scan_2);
+    ISAAC_PROTO_TX(OutputPathProto, output_path_2);
+    ISAAC_PROTO_TX(FlatscanProto, flatscan_3);
+    ISAAC_PROTO_TX(SafetyScanProto, safety_scan_3);
+    ISAAC_PROTO_TX(OutputPathProto, output_path_3);
+
     // Use persistent config from device (reads from sensor).
     ISAAC_PARAM(bool, use_persistent_config, false);
 
@@ -106,6 +191,11 @@ public:
     ISAAC_PARAM(int, channel, 0);
     // Determines whether to set the channel active.
     ISAAC_PARAM(bool, channel_enabled, true);
+    // Further measurement channels streamed over the same COLA2 session and UDP port. Each entry is
+    // an object with a mandatory "channel" and any of the per-channel parameters of this codelet
+    // (angles, data features, publishing_frequency_factor and the *_pub_active flags). Missing
+    // values are taken from the primary channel. Entry i is published on the outputs suffixed i+1.
+    ISAAC_PARAM(nlohmann::json, additional_channels, nlohmann::json::array());
 
     // If enabled, this codlet publishes simple flatscan protos.
     ISAAC_PARAM(bool, flatscan_pub_active, false);
@@ -114,6 +204,17 @@ public:
     // If enabled, this codlet publishes outputPath message protos.
     ISAAC_PARAM(bool, outputpath_pub_active, false);
 
+    // Beams flagged as not valid, glare, contaminated or with a contamination warning are
+    // published in the flatscan as invalid ranges (below InvalidRangeThreshold) if enabled.
+    ISAAC_PARAM(bool, flatscan_drop_invalid, false);
+    ISAAC_PARAM(bool, flatscan_drop_glare, false);
+    ISAAC_PARAM(bool, flatscan_drop_contamination, false);
+    ISAAC_PARAM(bool, flatscan_drop_contamination_warning, false);
+    // If enabled, beams flagged as infinite are published with a range of OutOfRangeThreshold.
+    ISAAC_PARAM(bool, flatscan_infinite_as_out_of_range, false);
+    // If enabled, the flatscan contains the reflectivity of each beam as visibility in [0, 1].
+    ISAAC_PARAM(bool, flatscan_visibilities, false);
+
     // Angle offset [deg].
     ISAAC_PARAM(float, angle_offset, -90.0f);
 
@@ -138,30 +239,228 @@ public:
     // Sensor data receive timeout [milliseconds]
     ISAAC_PARAM(int, receive_timeout, 5000);
 
+    // File in which type code, persistent config and the last applied settings are cached per
+    // device serial number. If set, a known device starts streaming without requesting them
+    // again; the cache is validated against the serial number of the first received scan.
+    ISAAC_PARAM(std::string, device_cache_path, "");
+    // Receive timeout while checking whether a device started from cache still streams with the
+    // cached settings [milliseconds]. The device is configured again if no scan arrives in time.
+    ISAAC_PARAM(int, cached_stream_timeout, 300);
+    // Number of consecutive receive timeouts after which the connection is re-established.
+    ISAAC_PARAM(int, reconnect_after_timeouts, 3);
+    // Initial and maximum delay between two connection attempts [seconds]. The delay is doubled
+    // after every failed attempt.
+    ISAAC_PARAM(double, reconnect_backoff_min, 0.1);
+    ISAAC_PARAM(double, reconnect_backoff_max, 5.0);
+
+    // If enabled, a reduced flatscan of the primary channel is published on flatscan_viz. Every
+    // angular bin holds the smallest range of its beams and the rate is capped, so the bandwidth
+    // does not depend on the sensor configuration.
+    ISAAC_PARAM(bool, viz_pub_active, false);
+    // Number of angular bins of flatscan_viz.
+    ISAAC_PARAM(int, viz_bins, 270);
+    // Maximum publishing rate of flatscan_viz [Hz].
+    ISAAC_PARAM(double, viz_max_rate, 5.0);
+
+    // If enabled, scans are collected and published in batches on safety_scan_batch.
+    ISAAC_PARAM(bool, batch_pub_active, false);
+    // Maximum number of scans per batch.
+    ISAAC_PARAM(int, batch_size, 10);
+    // Maximum time the oldest scan of a batch waits before the batch is published
+    // [milliseconds]. 0 only publishes full batches.
+    ISAAC_PARAM(double, batch_latency, 0.0);
+
+    // If enabled, scans are received on a socket of this codelet and the measurement data is
+    // decoded directly into the safety scan message instead of through the scan point objects
+    // of the library. Only considered when connecting.
+    ISAAC_PARAM(bool, direct_decoder_active, false);
+    // If enabled, the codelet ticks periodically instead of blocking in receive and processes all
+    // datagrams which are ready without waiting. Implies direct_decoder_active. Only considered
+    // on start.
+    ISAAC_PARAM(bool, reactor_mode, false);
+    // Tick period of the reactor mode [milliseconds]. Datagrams wait up to this long before they
+    // are processed.
+    ISAAC_PARAM(double, reactor_poll_interval, 5.0);
+    // CPUs the receiving thread is pinned to. Empty keeps the default affinity.
+    ISAAC_PARAM(std::vector<int>, cpu_affinity, {});
+    // SCHED_FIFO priority of the receiving thread in [1, 99]. 0 keeps the default scheduling.
+    // Affinity and priority are not applied in reactor mode, as the codelet then runs on the
+    // shared worker threads.
+    ISAAC_PARAM(int, realtime_priority, 0);
+    // If enabled, all pages of the process are locked into memory to avoid page faults.
+    ISAAC_PARAM(bool, lock_memory, false);
+    // Kernel receive buffer of the UDP socket [bytes]. 0 keeps the system default. Only applies
+    // to the socket of the direct decoder.
+    ISAAC_PARAM(int, socket_receive_buffer, 0);
+
+    // If set, the direct decoder appends every received datagram payload to this file. Such
+    // captures are used to validate the decoder against the library, see tests/ScanDatagram.cpp.
+    ISAAC_PARAM(std::string, datagram_capture_path, "");
+
+    // If enabled, bulk channels (flatscan) are decimated while the publishing path falls behind.
+    // Safety relevant channels (safety_scan, output_path) are always published at full rate.
+    ISAAC_PARAM(bool, adaptive_rate_active, false);
+    // Time budget for converting and publishing a single scan [milliseconds].
+    ISAAC_PARAM(double, adaptive_latency_budget, 10.0);
+    // Upper bound of the decimation factor applied to the flatscan channel.
+    ISAAC_PARAM(int, flatscan_max_decimation, 4);
+
+    // If set, every scan is additionally written into a shared-memory ring in this file (e.g.
+    // /dev/shm/sick_scans) which external processes can read with SharedScanReader.
+    ISAAC_PARAM(std::string, shm_path, "");
+    // Number of scans kept in the shared-memory ring.
+    ISAAC_PARAM(int, shm_slot_count, 16);
+    // Maximum number of beams per scan in the shared-memory ring. Excess beams are cut off.
+    ISAAC_PARAM(int, shm_max_beams, 2048);
+
 private:
     sick::datastructure::CommSettings m_comm_settings;
-    std::unique_ptr<sick::SyncSickSafetyScanner> m_scanner;
+    // Shared with the request in flight, which may outlive the codelet after stop().
+    std::shared_ptr<sick::SyncSickSafetyScanner> m_scanner;
+    SensorRequest m_request{SensorRequest::kNone};
+    std::future<SensorReply> m_reply;
+    // Serial number of the device queried by a kIdentify request.
+    uint32_t m_requested_serial{0};
+    // What a kConfigure request applies: the primary channel followed by m_requested_channels.
+    bool m_configure_primary{false};
+    bool m_configure_additional{false};
+    std::vector<MeasurementChannel> m_requested_channels;
     ConfigurationParams m_prev_params;
+    ConfigurationParams m_persistent_config;
+    DeviceCache m_device_cache;
+    uint32_t m_serial_number{0};
+    bool m_identity_validated{false};
+    bool m_device_configured{false};
+    bool m_awaiting_cached_stream{false};
+    int m_consecutive_timeouts{0};
+    double m_reconnect_backoff{0.0};
+    std::chrono::steady_clock::time_point m_next_reconnect;
+    // Beams of the current scan, shared by all outputs except safety_scan.
+    ScanBeams m_scan_beams;
+    MinRangeBinning m_viz_binning;
+    std::chrono::steady_clock::time_point m_last_viz_publish;
+    bool m_realtime_applied{false};
+    bool m_reactor_mode{false};
+    // Time of the last received scan and the end of the last receive.
+    std::chrono::steady_clock::time_point m_last_scan;
+    std::chrono::steady_clock::time_point m_last_drain;
+    bool m_direct_decoder_active{false};
+    ScanDatagramReceiver m_datagram_receiver;
+    std::ofstream m_datagram_capture;
+    // The UDP port the sensor is configured to stream to.
+    int m_host_udp_port{0};
     float m_range_min{0.1};
     float m_range_max{std::numeric_limits<float>::infinity()};
     uint8_t m_e_interface_type{0};
+    LoadMonitor m_load_monitor;
+    // The primary channel followed by all additional channels.
+    std::vector<MeasurementChannel> m_channels;
+    nlohmann::json m_prev_additional_channels;
+    SharedScanWriter m_shared_ring;
+    std::string m_shared_ring_path;
 
+    // Opens the receiver and sends a connect request, which also queries the identity of the
+    // device if requested. Returns false if the request could not be sent.
+    bool connect(bool query_identity);
+    // Drops the connection to the sensor and schedules a reconnect.
+    void disconnect();
+    // Sets the time of the next connection attempt and increases the backoff.
+    void scheduleReconnect();
+    // Starts a connection attempt if the backoff has elapsed and no request is in flight.
+    void reconnect();
+    // Runs a COLA2 request on a thread of its own. Its reply is handled by collectReply().
+    void startRequest(SensorRequest kind, std::function<SensorReply()> request);
+    // Handles the reply of the request in flight. Returns false while the request is pending or
+    // if the connection has been dropped. Blocking ticks wait for the reply in slices.
+    bool collectReply();
+    // Applies affinity, priority and memory locking to the calling thread and reports the result.
+    // Settings which can not be applied are reported and skipped.
+    void applyRealtimeSettings();
+    // Receives the next scan. Returns false on timeout.
+    bool receiveScan(int timeout, sick::datastructure::Data &data);
+    // Publishes a received scan on the outputs of its channel. Returns false if the connection has
+    // been dropped or the identity of the device is being requested.
+    bool processScan(sick::datastructure::Data &data,
+                     std::chrono::steady_clock::time_point wait_start);
+    // Processes all scans which are ready without blocking. Handles a receive timeout if no scan
+    // arrived for the given time [milliseconds]. Returns false if the connection has been dropped.
+    bool drainDatagrams(int timeout);
+    // Waits for the next scan in slices, so that a blocking tick returns in time for stop().
+    // Handles a receive timeout if no scan arrived for the given time [milliseconds]. Returns false
+    // if the connection has been dropped.
+    bool receiveBlocking(int timeout);
+    // Reconfigures or reconnects the sensor if no data is received. Returns false if the
+    // connection has been dropped or the sensor is being configured.
+    bool handleReceiveTimeout();
+    // Resets the state of the device before connecting.
+    void resetDevice();
+    // Takes over the connection and the identity of the device from the reply to a connect
+    // request. Returns false if the device could not be reached or queried.
+    bool initializeDevice(SensorReply &reply);
+    // Compares the serial number of the first received scan with the cached identity. Returns
+    // false if the identity of a different device is requested.
+    bool validateDeviceIdentity(const sick::datastructure::Data &data);
+    // Takes over the identity of a different device from the reply to an identify request.
+    // Returns false if the device could not be queried.
+    bool finishIdentification(const SensorReply &reply);
+    // Reads the device cache file.
+    void loadDeviceCache();
+    // Applies the cache entry of the sensor. Returns false if there is none.
+    bool loadCachedDevice();
+    // Updates the cache entry of the sensor and writes the cache file.
+    void storeDeviceCache();
+    // Sends the settings of the primary and/or the additional channels to the sensor. The primary
+    // channel is marked as being configured in the device cache. Returns false if there is
+    // nothing to send.
+    bool requestConfiguration(bool primary, bool additional);
+    // Takes over the channels from the reply to a configure request and records the applied
+    // settings in the device cache. Returns false if the primary channel could not be configured.
+    bool finishConfiguration(const SensorReply &reply);
+    // The primary channel configuration given by the ISAAC_PARAMs.
+    ConfigurationParams currentParams();
     // Determines whether the ISAAC_PARAMs have been changed since the last tick.
     bool isParamSetDirty();
-    // Update the configuration of the sensor. IP and port updates are ignored by a SickSafetyScanner instance after initialization.
-    void updateDeviceConfig();
+    // The settings which configure a channel of the sensor. IP and port updates are ignored by a SickSafetyScanner instance after initialization.
+    sick::datastructure::CommSettings toCommSettings(const ConfigurationParams &params);
+    // Parses additional_channels into m_requested_channels. Returns the channels which are no
+    // longer listed and have to be disabled.
+    std::vector<int> parseAdditionalChannels();
+    // Returns the channel the given scan belongs to. Scans of unknown channels belong to the primary channel.
+    MeasurementChannel &channelOf(const sick::datastructure::Data &data);
     // Updates the internal set of previous ISAAC_PARAM values.
     void updatePrevParams();
-    // Requests the persistent configuration from the sensor.
-    void readConfigFromDevice();
-    // Requests the type information from the sensor.
-    void readTypeCodeSettings();
+    // Feeds the timings of the current scan to the adaptive rate control [seconds].
+    void updateAdaptiveRate(double publish_latency, double receive_wait);
+    // Takes over the persistent configuration read from the sensor.
+    void applyConfigData(const sick::datastructure::ConfigData &config_data);
+    // Overwrites the ISAAC_PARAMs of the primary channel with the persistent configuration.
+    void applyPersistentConfig(const ConfigurationParams &params);
+    // Takes over the type information read from the sensor.
+    void applyTypeCode(const sick::datastructure::TypeCode &type_code);
+    // (Re-)opens the shared-memory ring if shm_path has been changed.
+    void updateSharedMemory();
+    // Writes a scan into the shared-memory ring.
+    void publishSharedMemory(const sick::datastructure::Data &data, const MeasurementChannel &channel);
+    // Fills m_scan_beams with the beams of a scan, directly from the datagram if the direct
+    // decoder is active.
+    void extractScanBeams(const sick::datastructure::Data &data,
+                          const MeasurementChannel &channel);
+    // Returns true if the next flatscan_viz is due according to viz_max_rate.
+    bool isVisualizationDue(const MeasurementChannel &channel) const;
+    // Assemble and publish the reduced flatscan for visualization.
+    void publishVisualization(const sick::datastructure::Data &data, const MeasurementChannel &channel);
+    // Appends a scan to the batch of its channel. Publishes the batch if it is due.
+    void appendToBatch(const sick::datastructure::Data &data, MeasurementChannel &channel);
+    // Publishes the batches whose latency budget has been exceeded.
+    void publishDueBatches();
+    // Publishes the scans of a batch and clears it.
+    void publishBatch(ScanBatch &batch);
     // Assemble and publish a flatscan proto from sensor data.
-    void publishFlatScanProto(const sick::datastructure::Data &data);
+    void publishFlatScanProto(const sick::datastructure::Data &data, MeasurementChannel &channel);
     // Assemble and publish a safety scan proto from sensor data.
-    void publishSafetyScan(const sick::datastructure::Data &data);
+    void publishSafetyScan(const sick::datastructure::Data &data, MeasurementChannel &channel);
     // Assemble and publish an output path proto from sensor data.
-    void publishOutputPath(const sick::datastructure::Data &data);
+    void publishOutputPath(const sick::datastructure::Data &data, MeasurementChannel &channel);
 };
 
 } // namespace sick_components
@@ -0,0 +1,226 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    ThroughputProbe.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "ThroughputProbe.hpp"
+
+#include <chrono>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+// Histogram ranges: latencies and decode times from 1 us to 10 s, sizes from 8 B to 100 MB.
+constexpr double kMinTime = 1e-6;
+constexpr double kMaxTime = 10.0;
+constexpr double kMinSize = 8.0;
+constexpr double kMaxSize = 1e8;
+constexpr int kBinsPerDecade = 10;
+
+// Reads every field of a message once, so that the measured time covers the full decoding cost
+// of a consumer. The returned value only exists to keep the compiler from dropping the reads.
+float Traverse(SafetyScanProto::Reader reader) {
+  float checksum = reader.getHeader().getScanNumber();
+  checksum += reader.getDerivedValues().getNumberOfBeams();
+  for (const auto scan_point : reader.getMeasurementData().getScanPoints()) {
+    const auto status = scan_point.getStatus();
+    checksum += scan_point.getAngle() + scan_point.getDistance() +
+                status.getReflectivity() + status.getValid() +
+                status.getInfinite() + status.getGlare() +
+                status.getReflector() + status.getContamination() +
+                status.getContaminationWarning();
+  }
+  for (const auto datum : reader.getIntrusionData().getData()) {
+    for (const bool flag : datum.getFlags()) {
+      checksum += flag;
+    }
+  }
+  return checksum;
+}
+
+float Traverse(FlatscanProto::Reader reader) {
+  float checksum = 0.0f;
+  for (const float range : reader.getRanges()) {
+    checksum += range;
+  }
+  for (const float angle : reader.getAngles()) {
+    checksum += angle;
+  }
+  return checksum;
+}
+
+float Traverse(OutputPathProto::Reader reader) {
+  float checksum = reader.getActiveMonitoringCase();
+  for (std::size_t i = 0; i < reader.getStatus().size(); i++) {
+    checksum += reader.getStatus()[i] + reader.getIsSafe()[i] +
+                reader.getIsValid()[i];
+  }
+  return checksum;
+}
+
+float Traverse(SafetyScanBatchProto::Reader reader) {
+  float checksum = reader.getNumberOfBeams();
+  for (const auto scan_number : reader.getScanNumber()) {
+    checksum += scan_number;
+  }
+  for (const auto distance : reader.getDistance()) {
+    checksum += distance;
+  }
+  for (const auto reflectivity : reader.getReflectivity()) {
+    checksum += reflectivity;
+  }
+  for (const auto status : reader.getStatus()) {
+    checksum += status;
+  }
+  return checksum;
+}
+
+// Measures the time it takes to traverse a message [seconds].
+template <typename Reader> double MeasureDecodeTime(Reader reader) {
+  const auto begin = std::chrono::steady_clock::now();
+  volatile float checksum = Traverse(reader);
+  (void)checksum;
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - begin).count();
+}
+
+template <typename Reader> uint64_t SizeInBytes(Reader reader) {
+  return reader.totalSize().wordCount * sizeof(capnp::word);
+}
+
+} // namespace
+
+ThroughputProbe::ChannelStatistics::ChannelStatistics(const std::string &name)
+    : name(name), latency(kMinTime, kMaxTime, kBinsPerDecade),
+      decode_time(kMinTime, kMaxTime, kBinsPerDecade),
+      size(kMinSize, kMaxSize, kBinsPerDecade) {}
+
+void ThroughputProbe::start() {
+  LOG_INFO("Starting ThroughputProbe node");
+  const std::string label = get_label();
+  const std::string prefix = label.empty() ? "" : label + ".";
+  m_safety_scan_statistics =
+      std::make_unique<ChannelStatistics>(prefix + "safety_scan");
+  m_flatscan_statistics =
+      std::make_unique<ChannelStatistics>(prefix + "flatscan");
+  m_output_path_statistics =
+      std::make_unique<ChannelStatistics>(prefix + "output_path");
+  m_safety_scan_batch_statistics =
+      std::make_unique<ChannelStatistics>(prefix + "safety_scan_batch");
+  m_last_report_time = getTickTime();
+
+  tickOnMessage(rx_safety_scan());
+  tickOnMessage(rx_flatscan());
+  tickOnMessage(rx_output_path());
+  tickOnMessage(rx_safety_scan_batch());
+}
+
+void ThroughputProbe::stop() { LOG_INFO("Stopping ThroughputProbe node"); }
+
+void ThroughputProbe::tick() {
+  rx_safety_scan().processAllNewMessages(
+      [this](SafetyScanProto::Reader reader, int64_t pubtime, int64_t) {
+        addSample(*m_safety_scan_statistics, pubtime,
+                  MeasureDecodeTime(reader), SizeInBytes(reader));
+      });
+  rx_flatscan().processAllNewMessages(
+      [this](FlatscanProto::Reader reader, int64_t pubtime, int64_t) {
+        addSample(*m_flatscan_statistics, pubtime, MeasureDecodeTime(reader),
+                  SizeInBytes(reader));
+      });
+  rx_output_path().processAllNewMessages(
+      [this](OutputPathProto::Reader reader, int64_t pubtime, int64_t) {
+        addSample(*m_output_path_statistics, pubtime,
+                  MeasureDecodeTime(reader), SizeInBytes(reader));
+      });
+  rx_safety_scan_batch().processAllNewMessages(
+      [this](SafetyScanBatchProto::Reader reader, int64_t pubtime, int64_t) {
+        addSample(*m_safety_scan_batch_statistics, pubtime,
+                  MeasureDecodeTime(reader), SizeInBytes(reader));
+      });
+
+  const double now = getTickTime();
+  const double interval = now - m_last_report_time;
+  if (interval >= get_report_interval()) {
+    report(*m_safety_scan_statistics, interval);
+    report(*m_flatscan_statistics, interval);
+    report(*m_output_path_statistics, interval);
+    report(*m_safety_scan_batch_statistics, interval);
+    m_last_report_time = now;
+  }
+}
+
+void ThroughputProbe::addSample(ChannelStatistics &statistics, int64_t pubtime,
+                                double decode_time, uint64_t size_in_bytes) {
+  const int64_t now = node()->clock()->timestamp();
+  statistics.latency.add(static_cast<double>(now - pubtime) * 1e-9);
+  statistics.decode_time.add(decode_time);
+  statistics.size.add(static_cast<double>(size_in_bytes));
+  statistics.total_count++;
+}
+
+void ThroughputProbe::report(ChannelStatistics &statistics, double interval) {
+  if (statistics.latency.count() == 0) {
+    return;
+  }
+  const std::string &name = statistics.name;
+  const double rate = statistics.latency.count() / interval;
+
+  show(name + ".rate", rate);
+  show(name + ".size.mean", statistics.size.mean());
+  show(name + ".latency.p50", statistics.latency.percentile(0.5) * 1e3);
+  show(name + ".latency.p99", statistics.latency.percentile(0.99) * 1e3);
+  show(name + ".latency.max", statistics.latency.max() * 1e3);
+  show(name + ".decode_time.p50", statistics.decode_time.percentile(0.5) * 1e6);
+  show(name + ".decode_time.p99",
+       statistics.decode_time.percentile(0.99) * 1e6);
+
+  if (get_log_reports()) {
+    LOG_INFO("%s: %.1f msg/s, %.0f bytes/msg, latency [ms] p50=%.3f "
+             "p99=%.3f max=%.3f, decode [us] p50=%.1f p99=%.1f, total=%llu",
+             name.c_str(), rate, statistics.size.mean(),
+             statistics.latency.percentile(0.5) * 1e3,
+             statistics.latency.percentile(0.99) * 1e3,
+             statistics.latency.max() * 1e3,
+             statistics.decode_time.percentile(0.5) * 1e6,
+             statistics.decode_time.percentile(0.99) * 1e6,
+             static_cast<unsigned long long>(statistics.total_count));
+  }
+
+  statistics.latency.reset();
+  statistics.decode_time.reset();
+  statistics.size.reset();
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
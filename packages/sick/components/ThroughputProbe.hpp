@@ -0,0 +1,109 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    ThroughputProbe.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "engine/alice/alice_codelet.hpp"
+#include "messages/messages.hpp"
+
+#include "packages/sick/messages/safety_scan.hpp"
+#include "packages/sick/messages/safety_scan_batch.hpp"
+#include "packages/sick/gems/histogram.hpp"
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Measures receive rate, message size, decode time and publish-to-receive latency of the channels
+// published by the SickSafetyScanner codelet and periodically reports histograms of them. Any
+// subset of the inputs can be connected, and any output of the codelet can be connected to the
+// input of the same type, e.g. flatscan_viz or flatscan_1 to flatscan. To measure several outputs
+// of the same type, use one probe with its own label per output. Intended for load tests and
+// throughput benchmarks.
+class ThroughputProbe : public isaac::alice::Codelet
+{
+public:
+    void start() override;
+    void tick() override;
+    void stop() override;
+
+    ISAAC_PROTO_RX(SafetyScanProto, safety_scan);
+    ISAAC_PROTO_RX(FlatscanProto, flatscan);
+    ISAAC_PROTO_RX(OutputPathProto, output_path);
+    ISAAC_PROTO_RX(SafetyScanBatchProto, safety_scan_batch);
+
+    // Interval between two reports [seconds].
+    ISAAC_PARAM(double, report_interval, 5.0);
+    // If enabled, every report is also written to the log.
+    ISAAC_PARAM(bool, log_reports, true);
+    // Prefix of the reported names, e.g. "viz" reports "viz.flatscan.rate". Only considered on
+    // start.
+    ISAAC_PARAM(std::string, label, "");
+
+private:
+    // Statistics of a single channel since the last report.
+    struct ChannelStatistics
+    {
+        explicit ChannelStatistics(const std::string &name);
+
+        std::string name;
+        // Publish-to-receive latency [seconds].
+        Histogram latency;
+        // Time to traverse the received message [seconds].
+        Histogram decode_time;
+        // Serialized message size [bytes].
+        Histogram size;
+        uint64_t total_count{0};
+    };
+
+    // Adds the measurements of a single message to the given statistics.
+    void addSample(ChannelStatistics &statistics, int64_t pubtime, double decode_time,
+                   uint64_t size_in_bytes);
+    // Shows and logs the statistics of a channel and resets them.
+    void report(ChannelStatistics &statistics, double interval);
+
+    std::unique_ptr<ChannelStatistics> m_safety_scan_statistics;
+    std::unique_ptr<ChannelStatistics> m_flatscan_statistics;
+    std::unique_ptr<ChannelStatistics> m_output_path_statistics;
+    std::unique_ptr<ChannelStatistics> m_safety_scan_batch_statistics;
+    double m_last_report_time{0.0};
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
+
+ISAAC_ALICE_REGISTER_CODELET(isaac::sick_safetyscanners::ThroughputProbe);
@@ -0,0 +1,116 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    adaptive_rate.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "adaptive_rate.hpp"
+
+#include <algorithm>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+void LoadMonitor::configure(double latency_budget, double smoothing,
+                            double backlog_wait_threshold) {
+  latency_budget_ = std::max(latency_budget, 0.0);
+  smoothing_ = std::min(std::max(smoothing, 1e-3), 1.0);
+  backlog_wait_threshold_ = std::max(backlog_wait_threshold, 0.0);
+}
+
+void LoadMonitor::reset() {
+  latency_ = 0.0;
+  backlog_ = 0;
+  has_samples_ = false;
+}
+
+void LoadMonitor::addSample(double publish_latency, double receive_wait) {
+  if (!has_samples_) {
+    latency_ = publish_latency;
+    has_samples_ = true;
+  } else {
+    latency_ += smoothing_ * (publish_latency - latency_);
+  }
+  backlog_ = (receive_wait < backlog_wait_threshold_) ? backlog_ + 1 : 0;
+}
+
+bool LoadMonitor::overloaded() const {
+  return has_samples_ &&
+         (latency_ > latency_budget_ || backlog_ >= kBacklogLimit);
+}
+
+bool LoadMonitor::relaxed() const {
+  return has_samples_ && latency_ < 0.5 * latency_budget_ && backlog_ == 0;
+}
+
+void AdaptiveDecimator::configure(int max_decimation) {
+  max_decimation_ = std::max(max_decimation, 1);
+  decimation_ = std::min(decimation_, max_decimation_);
+}
+
+void AdaptiveDecimator::reset() {
+  decimation_ = 1;
+  counter_ = 0;
+  relaxed_updates_ = 0;
+  hold_updates_ = 0;
+}
+
+void AdaptiveDecimator::update(const LoadMonitor &monitor) {
+  if (hold_updates_ > 0) {
+    hold_updates_--;
+    return;
+  }
+  if (monitor.overloaded()) {
+    if (decimation_ < max_decimation_) {
+      decimation_ = std::min(2 * decimation_, max_decimation_);
+      hold_updates_ = kHoldUpdates;
+    }
+    relaxed_updates_ = 0;
+  } else if (monitor.relaxed()) {
+    if (++relaxed_updates_ >= kRelaxedUpdatesLimit) {
+      decimation_ = std::max(decimation_ - 1, 1);
+      relaxed_updates_ = 0;
+    }
+  } else {
+    relaxed_updates_ = 0;
+  }
+}
+
+bool AdaptiveDecimator::tick() {
+  if (counter_ >= decimation_ - 1) {
+    counter_ = 0;
+    return true;
+  }
+  counter_++;
+  return false;
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,106 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    adaptive_rate.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Observes the time spent on publishing a scan and the time spent waiting for the next one and
+// decides whether the publishing path is falling behind the sensor.
+class LoadMonitor
+{
+public:
+    // Latency budget per scan [seconds], smoothing factor of the moving average in ]0, 1] and the
+    // receive wait time [seconds] below which a scan is assumed to have been queued already.
+    void configure(double latency_budget, double smoothing, double backlog_wait_threshold);
+    // Forgets all previous observations.
+    void reset();
+    // Adds the observations of a single scan. Both values are given in [seconds].
+    void addSample(double publish_latency, double receive_wait);
+
+    // True if the smoothed publish latency exceeds the budget or scans are queueing up.
+    bool overloaded() const;
+    // True if the smoothed publish latency is well below the budget and no scans are queued.
+    bool relaxed() const;
+    // Smoothed publish latency [seconds].
+    double latency() const { return latency_; }
+    // Number of consecutive scans which were already waiting when receive was called.
+    int backlog() const { return backlog_; }
+
+private:
+    // Number of consecutive queued scans after which the publisher counts as overloaded.
+    static constexpr int kBacklogLimit = 3;
+
+    double latency_budget_{0.01};
+    double smoothing_{0.1};
+    double backlog_wait_threshold_{0.001};
+    double latency_{0.0};
+    int backlog_{0};
+    bool has_samples_{false};
+};
+
+// Publishes only every n-th message of a channel. n is doubled while the publisher is overloaded
+// and decremented once it has been relaxed for a while, but always stays within [1, max]. After
+// each change the decimation is held for a few updates to let the smoothed latency settle.
+class AdaptiveDecimator
+{
+public:
+    // Sets the upper bound of the decimation factor. A bound of 1 disables decimation.
+    void configure(int max_decimation);
+    // Resets the decimation factor to 1.
+    void reset();
+    // Adjusts the decimation factor to the current load of the publisher.
+    void update(const LoadMonitor &monitor);
+    // Returns true if the current message is to be published and advances the internal counter.
+    bool tick();
+    // The current decimation factor.
+    int decimation() const { return decimation_; }
+
+private:
+    // Number of consecutive relaxed updates before the decimation is lowered.
+    static constexpr int kRelaxedUpdatesLimit = 50;
+    // Number of updates the decimation is held after it has been raised.
+    static constexpr int kHoldUpdates = 10;
+
+    int max_decimation_{1};
+    int decimation_{1};
+    int counter_{0};
+    int relaxed_updates_{0};
+    int hold_updates_{0};
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,142 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    device_cache.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "device_cache.hpp"
+
+#include <fstream>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+constexpr char kAddresses[] = "addresses";
+constexpr char kDevices[] = "devices";
+constexpr char kAppliedSettings[] = "applied_settings";
+
+} // namespace
+
+bool DeviceCache::load(const std::string &path) {
+  json_ = nlohmann::json::object();
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return true;
+  }
+  nlohmann::json json = nlohmann::json::parse(file, nullptr, false);
+  if (json.is_discarded() || !json.is_object()) {
+    return false;
+  }
+  json_ = json;
+  return true;
+}
+
+bool DeviceCache::save(const std::string &path) const {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    return false;
+  }
+  file << json_.dump(2);
+  return file.good();
+}
+
+uint32_t DeviceCache::serialNumber(const std::string &address) const {
+  const auto addresses = json_.find(kAddresses);
+  if (addresses == json_.end() || !addresses->is_object()) {
+    return 0;
+  }
+  const auto serial = addresses->find(address);
+  if (serial == addresses->end() || !serial->is_string()) {
+    return 0;
+  }
+  try {
+    return std::stoul(serial->get<std::string>());
+  } catch (const std::exception &) {
+    return 0;
+  }
+}
+
+void DeviceCache::setSerialNumber(const std::string &address,
+                                  uint32_t serial_number) {
+  json_[kAddresses][address] = std::to_string(serial_number);
+}
+
+const nlohmann::json *DeviceCache::findDevice(uint32_t serial_number) const {
+  const auto devices = json_.find(kDevices);
+  if (devices == json_.end() || !devices->is_object()) {
+    return nullptr;
+  }
+  const auto device = devices->find(std::to_string(serial_number));
+  if (device == devices->end() || !device->is_object()) {
+    return nullptr;
+  }
+  return &*device;
+}
+
+nlohmann::json &DeviceCache::device(uint32_t serial_number) {
+  // Entries of an unexpected type, e.g. from an edited file, are replaced
+  nlohmann::json &devices = json_[kDevices];
+  if (!devices.is_object()) {
+    devices = nlohmann::json::object();
+  }
+  nlohmann::json &device = devices[std::to_string(serial_number)];
+  if (!device.is_object()) {
+    device = nlohmann::json::object();
+  }
+  return device;
+}
+
+bool DeviceCache::isStreaming(uint32_t serial_number,
+                              const nlohmann::json &settings) const {
+  const nlohmann::json *entry = findDevice(serial_number);
+  if (entry == nullptr) {
+    return false;
+  }
+  const auto applied_settings = entry->find(kAppliedSettings);
+  return applied_settings != entry->end() && *applied_settings == settings;
+}
+
+void DeviceCache::beginConfiguration(uint32_t serial_number) {
+  // A device which is not cached has no applied settings to forget
+  if (findDevice(serial_number) != nullptr) {
+    device(serial_number).erase(kAppliedSettings);
+  }
+}
+
+void DeviceCache::finishConfiguration(uint32_t serial_number,
+                                      const nlohmann::json &settings) {
+  device(serial_number)[kAppliedSettings] = settings;
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,84 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    device_cache.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "engine/gems/serialization/json.hpp"
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Identity and settings of devices, stored as JSON and keyed by serial number. The settings a
+// device was last configured with are only recorded once the configuration succeeded and are
+// removed before it is configured again, so the cache never claims settings the device may not
+// stream with.
+class DeviceCache
+{
+public:
+    // Reads the cache from a file. A missing file yields an empty cache. Returns false and leaves
+    // the cache empty if the file is invalid.
+    bool load(const std::string &path);
+    // Writes the cache to a file. Returns false on failure.
+    bool save(const std::string &path) const;
+
+    // Serial number of the device last seen at the given address, or 0 if unknown.
+    uint32_t serialNumber(const std::string &address) const;
+    void setSerialNumber(const std::string &address, uint32_t serial_number);
+
+    // Entry of a device, or nullptr if it is not cached.
+    const nlohmann::json *findDevice(uint32_t serial_number) const;
+    // Entry of a device, created if it is not cached or not an object.
+    nlohmann::json &device(uint32_t serial_number);
+
+    // True if the device was last configured with exactly these settings, i.e. it keeps
+    // streaming with them after a restart of the driver.
+    bool isStreaming(uint32_t serial_number, const nlohmann::json &settings) const;
+    // To be called before configuring a device; forgets its applied settings.
+    void beginConfiguration(uint32_t serial_number);
+    // To be called after a device was configured successfully.
+    void finishConfiguration(uint32_t serial_number, const nlohmann::json &settings);
+
+    const nlohmann::json &json() const { return json_; }
+
+private:
+    nlohmann::json json_ = nlohmann::json::object();
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,111 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    histogram.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+Histogram::Histogram(double min, double max, int bins_per_decade) {
+  min = std::max(min, 1e-12);
+  max = std::max(max, min);
+  bins_per_decade_ = std::max(bins_per_decade, 1);
+  log_min_ = std::log10(min);
+  const int n_bins = std::max(
+      1, static_cast<int>(std::ceil((std::log10(max) - log_min_) *
+                                    bins_per_decade_)) +
+             1);
+  edges_.resize(n_bins);
+  for (int i = 0; i < n_bins; i++) {
+    edges_[i] = std::pow(10.0, log_min_ + i / bins_per_decade_);
+  }
+  counts_.assign(n_bins, 0);
+}
+
+void Histogram::add(double value) {
+  int bin = 0;
+  if (value > edges_.front()) {
+    bin = static_cast<int>((std::log10(value) - log_min_) * bins_per_decade_);
+    bin = std::min(std::max(bin, 0), static_cast<int>(counts_.size()) - 1);
+  }
+  counts_[bin]++;
+
+  if (count_ == 0) {
+    min_ = value;
+    max_ = value;
+  } else {
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+  sum_ += value;
+  count_++;
+}
+
+void Histogram::reset() {
+  std::fill(counts_.begin(), counts_.end(), 0);
+  count_ = 0;
+  sum_ = 0.0;
+  min_ = 0.0;
+  max_ = 0.0;
+}
+
+double Histogram::min() const { return min_; }
+
+double Histogram::max() const { return max_; }
+
+double Histogram::mean() const {
+  return count_ == 0 ? 0.0 : sum_ / static_cast<double>(count_);
+}
+
+double Histogram::percentile(double p) const {
+  if (count_ == 0) {
+    return 0.0;
+  }
+  const double rank = std::min(std::max(p, 0.0), 1.0) * count_;
+  uint64_t accumulated = 0;
+  for (std::size_t i = 0; i < counts_.size(); i++) {
+    accumulated += counts_[i];
+    if (accumulated >= rank && accumulated > 0) {
+      const double upper =
+          (i + 1 < edges_.size()) ? edges_[i + 1] : max_;
+      return std::min(upper, max_);
+    }
+  }
+  return max_;
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,83 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    histogram.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// A histogram with logarithmically spaced bins for positive values which span several orders of
+// magnitude, e.g. latencies or message sizes. Values outside of [min, max] are counted in the
+// first or last bin. Memory is allocated only on construction.
+class Histogram
+{
+public:
+    Histogram(double min, double max, int bins_per_decade);
+
+    // Adds a single sample.
+    void add(double value);
+    // Removes all samples.
+    void reset();
+
+    // Number of samples since the last reset.
+    uint64_t count() const { return count_; }
+    // Smallest, largest and mean value of all samples. Zero if there are no samples.
+    double min() const;
+    double max() const;
+    double mean() const;
+    // Estimates the given percentile in [0, 1] as the upper edge of the bin containing it.
+    double percentile(double p) const;
+
+    // Lower edges of all bins.
+    const std::vector<double> &edges() const { return edges_; }
+    // Number of samples in each bin.
+    const std::vector<uint64_t> &counts() const { return counts_; }
+
+private:
+    double log_min_;
+    double bins_per_decade_;
+    std::vector<double> edges_;
+    std::vector<uint64_t> counts_;
+    uint64_t count_{0};
+    double sum_{0.0};
+    double min_{0.0};
+    double max_{0.0};
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
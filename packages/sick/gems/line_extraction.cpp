@@ -0,0 +1,309 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    line_extraction.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "line_extraction.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Wraps an angle to [-pi, pi]
+double WrapAngle(double angle) {
+  return std::atan2(std::sin(angle), std::cos(angle));
+}
+
+} // namespace
+
+bool LineExtractor::extract(const std::vector<float> &angles,
+                            const std::vector<float> &ranges,
+                            float invalid_range, float out_of_range,
+                            std::chrono::steady_clock::time_point deadline) {
+  segments_.clear();
+  updateDirections(angles);
+
+  const std::size_t n_beams = std::min(ranges.size(), cos_.size());
+  xs_.clear();
+  ys_.clear();
+  beams_.clear();
+  for (std::size_t i = 0; i < n_beams; i++) {
+    const float range = ranges[i];
+    if (!(range >= invalid_range) || !(range < out_of_range)) {
+      continue;
+    }
+    xs_.push_back(range * cos_[i]);
+    ys_.push_back(range * sin_[i]);
+    beams_.push_back(static_cast<uint32_t>(i));
+  }
+
+  bool complete = split(deadline) && merge(deadline);
+
+  for (const Interval &interval : intervals_) {
+    const LineSegment segment = fit(interval);
+    const float length = std::hypot(segment.end_x - segment.start_x,
+                                    segment.end_y - segment.start_y);
+    if (length < params_.min_length) {
+      continue;
+    }
+    if (segments_.size() >= params_.max_segments) {
+      complete = false;
+      break;
+    }
+    segments_.push_back(segment);
+  }
+  return complete;
+}
+
+void LineExtractor::updateDirections(const std::vector<float> &angles) {
+  if (angles == angles_) {
+    return;
+  }
+  angles_ = angles;
+  cos_.resize(angles.size());
+  sin_.resize(angles.size());
+  for (std::size_t i = 0; i < angles.size(); i++) {
+    cos_[i] = std::cos(angles[i]);
+    sin_[i] = std::sin(angles[i]);
+  }
+}
+
+bool LineExtractor::split(std::chrono::steady_clock::time_point deadline) {
+  const std::size_t min_points =
+      static_cast<std::size_t>(std::max(params_.min_points, 2));
+  const float max_gap_squared = params_.max_gap * params_.max_gap;
+  intervals_.clear();
+  stack_.clear();
+
+  // Clusters of points without range gaps
+  std::size_t begin = 0;
+  for (std::size_t i = 1; i <= xs_.size(); i++) {
+    if (i < xs_.size()) {
+      const float dx = xs_[i] - xs_[i - 1];
+      const float dy = ys_[i] - ys_[i - 1];
+      if (dx * dx + dy * dy <= max_gap_squared) {
+        continue;
+      }
+    }
+    if (i - begin >= min_points) {
+      stack_.emplace_back(begin, i);
+    }
+    begin = i;
+  }
+
+  // Split at the point farthest from the chord until all points are close
+  while (!stack_.empty()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      std::sort(intervals_.begin(), intervals_.end());
+      return false;
+    }
+    const Interval interval = stack_.back();
+    stack_.pop_back();
+
+    const std::size_t first = interval.first;
+    const std::size_t last = interval.second - 1;
+    const float chord_x = xs_[last] - xs_[first];
+    const float chord_y = ys_[last] - ys_[first];
+    const float chord_length = std::hypot(chord_x, chord_y);
+
+    std::size_t farthest = first;
+    float max_distance = 0.0f;
+    for (std::size_t i = first + 1; i < last; i++) {
+      const float dx = xs_[i] - xs_[first];
+      const float dy = ys_[i] - ys_[first];
+      const float distance =
+          chord_length > 0.0f
+              ? std::abs(chord_x * dy - chord_y * dx) / chord_length
+              : std::hypot(dx, dy);
+      if (distance > max_distance) {
+        max_distance = distance;
+        farthest = i;
+      }
+    }
+
+    if (max_distance <= params_.split_threshold) {
+      intervals_.push_back(interval);
+      continue;
+    }
+    // The farthest point belongs to both halves
+    if (farthest + 1 - first >= min_points) {
+      stack_.emplace_back(first, farthest + 1);
+    }
+    if (interval.second - farthest >= min_points) {
+      stack_.emplace_back(farthest, interval.second);
+    }
+  }
+  std::sort(intervals_.begin(), intervals_.end());
+  return true;
+}
+
+bool LineExtractor::merge(std::chrono::steady_clock::time_point deadline) {
+  if (intervals_.empty()) {
+    return true;
+  }
+  const float max_gap_squared = params_.max_gap * params_.max_gap;
+
+  // Merged intervals are written to the front of intervals_
+  std::size_t merged = 0;
+  LineSegment current_line = fit(intervals_.front());
+  for (std::size_t k = 1; k < intervals_.size(); k++) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      // The remaining intervals are kept unmerged
+      const std::size_t remaining = intervals_.size() - k;
+      std::copy(intervals_.begin() + k, intervals_.end(),
+                intervals_.begin() + merged + 1);
+      intervals_.resize(merged + 1 + remaining);
+      return false;
+    }
+    Interval &current = intervals_[merged];
+    const Interval next = intervals_[k];
+    const LineSegment next_line = fit(next);
+
+    const std::size_t current_last = current.second - 1;
+    const float dx = xs_[next.first] - xs_[current_last];
+    const float dy = ys_[next.first] - ys_[current_last];
+    const bool neighbours = next.first <= current.second &&
+                            dx * dx + dy * dy <= max_gap_squared;
+    const bool collinear =
+        std::abs(WrapAngle(next_line.alpha - current_line.alpha)) <
+            params_.merge_angle &&
+        std::abs(next_line.r - current_line.r) < params_.merge_distance;
+    if (neighbours && collinear) {
+      const Interval joined(current.first, next.second);
+      const LineSegment joined_line = fit(joined);
+      if (maxResidual(joined, joined_line) <= params_.split_threshold) {
+        current = joined;
+        current_line = joined_line;
+        continue;
+      }
+    }
+    intervals_[++merged] = next;
+    current_line = next_line;
+  }
+  intervals_.resize(merged + 1);
+  return true;
+}
+
+LineSegment LineExtractor::fit(const Interval &interval) const {
+  const std::size_t first = interval.first;
+  const std::size_t last = interval.second - 1;
+  const double n = static_cast<double>(interval.second - interval.first);
+
+  double mean_x = 0.0;
+  double mean_y = 0.0;
+  for (std::size_t i = first; i <= last; i++) {
+    mean_x += xs_[i];
+    mean_y += ys_[i];
+  }
+  mean_x /= n;
+  mean_y /= n;
+
+  double sxx = 0.0;
+  double syy = 0.0;
+  double sxy = 0.0;
+  for (std::size_t i = first; i <= last; i++) {
+    const double dx = xs_[i] - mean_x;
+    const double dy = ys_[i] - mean_y;
+    sxx += dx * dx;
+    syy += dy * dy;
+    sxy += dx * dy;
+  }
+
+  // The line direction is the major axis of the scatter matrix, its normal
+  // the minor axis. The eigenvalues are the sums of squared distances along
+  // and across the line.
+  const double direction = 0.5 * std::atan2(2.0 * sxy, sxx - syy);
+  double alpha = direction + 0.5 * kPi;
+  double r = mean_x * std::cos(alpha) + mean_y * std::sin(alpha);
+  if (r < 0.0) {
+    r = -r;
+    alpha += kPi;
+  }
+  alpha = WrapAngle(alpha);
+  const double half_trace = 0.5 * (sxx + syy);
+  const double root =
+      std::sqrt(0.25 * (sxx - syy) * (sxx - syy) + sxy * sxy);
+  const double along = std::max(half_trace + root, 1e-12);
+  const double across = std::max(half_trace - root, 0.0);
+
+  const double cos_alpha = std::cos(alpha);
+  const double sin_alpha = std::sin(alpha);
+  const double noise = params_.range_noise * params_.range_noise;
+  const double variance =
+      n > 2.0 ? std::max(across / (n - 2.0), noise) : noise;
+  // Position of the centroid along the line, measured from the foot point of
+  // the normal. A rotation around the centroid changes r by this lever arm.
+  const double lever = -mean_x * sin_alpha + mean_y * cos_alpha;
+
+  LineSegment segment;
+  segment.alpha = static_cast<float>(alpha);
+  segment.r = static_cast<float>(r);
+  segment.var_alpha = static_cast<float>(variance / along);
+  segment.cov_alpha_r = static_cast<float>(lever * variance / along);
+  segment.var_r =
+      static_cast<float>(variance / n + lever * lever * variance / along);
+  segment.rms_error = static_cast<float>(std::sqrt(across / n));
+
+  // Project the outermost points onto the line
+  const auto project = [&](std::size_t i, float &x, float &y) {
+    const double distance = xs_[i] * cos_alpha + ys_[i] * sin_alpha - r;
+    x = static_cast<float>(xs_[i] - distance * cos_alpha);
+    y = static_cast<float>(ys_[i] - distance * sin_alpha);
+  };
+  project(first, segment.start_x, segment.start_y);
+  project(last, segment.end_x, segment.end_y);
+  segment.first_beam = beams_[first];
+  segment.last_beam = beams_[last];
+  segment.point_count = static_cast<uint32_t>(n);
+  return segment;
+}
+
+float LineExtractor::maxResidual(const Interval &interval,
+                                 const LineSegment &line) const {
+  const float cos_alpha = std::cos(line.alpha);
+  const float sin_alpha = std::sin(line.alpha);
+  float max_residual = 0.0f;
+  for (std::size_t i = interval.first; i < interval.second; i++) {
+    max_residual = std::max(
+        max_residual, std::abs(xs_[i] * cos_alpha + ys_[i] * sin_alpha - line.r));
+  }
+  return max_residual;
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,142 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    line_extraction.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// A line segment fitted to consecutive beams of a scan. All values are given in the sensor frame.
+struct LineSegment
+{
+    // End points, i.e. the first and last beam projected onto the line [meters].
+    float start_x{0.0f};
+    float start_y{0.0f};
+    float end_x{0.0f};
+    float end_y{0.0f};
+    // Line in Hessian normal form x * cos(alpha) + y * sin(alpha) = r with r >= 0 [radians, meters].
+    float alpha{0.0f};
+    float r{0.0f};
+    // Covariance of (alpha, r): variance of alpha, covariance of alpha and r, variance of r.
+    float var_alpha{0.0f};
+    float cov_alpha_r{0.0f};
+    float var_r{0.0f};
+    // Root mean square distance of the points to the line [meters].
+    float rms_error{0.0f};
+    // Indices of the first and last beam of the segment.
+    uint32_t first_beam{0};
+    uint32_t last_beam{0};
+    uint32_t point_count{0};
+};
+
+struct LineExtractionParams
+{
+    // Maximum distance of a point to the chord of its segment before the segment is split [meters].
+    float split_threshold{0.03f};
+    // Maximum distance between two consecutive points of a segment [meters].
+    float max_gap{0.2f};
+    // Minimum number of points and length of a segment [meters].
+    int min_points{6};
+    float min_length{0.3f};
+    // Neighbouring segments whose lines differ by less than these values are merged
+    // [radians, meters].
+    float merge_angle{0.05f};
+    float merge_distance{0.05f};
+    // Standard deviation of a range measurement, a lower bound for the point noise [meters].
+    float range_noise{0.01f};
+    // Maximum number of segments per scan. Further segments are dropped.
+    std::size_t max_segments{64};
+};
+
+// Extracts line segments from a scan with split-and-merge. The beams are split into clusters at
+// range gaps, clusters are split recursively at the point farthest from their chord, and
+// neighbouring segments on the same line are merged again. Lines are fitted with total least
+// squares. All buffers are kept between scans and the cos/sin table of the beam angles is only
+// recomputed when the angles change.
+class LineExtractor
+{
+public:
+    void setParams(const LineExtractionParams &params) { params_ = params; }
+
+    // Extracts the segments of a scan. Beams with a range below invalid_range or not below
+    // out_of_range are ignored. Returns false if the deadline passed before the scan was fully
+    // processed or if segments beyond max_segments were dropped. Parts of the scan which have not
+    // been split by the deadline are dropped, segments which have not been merged are kept.
+    bool extract(const std::vector<float> &angles, const std::vector<float> &ranges,
+                 float invalid_range, float out_of_range,
+                 std::chrono::steady_clock::time_point deadline);
+
+    const std::vector<LineSegment> &segments() const { return segments_; }
+
+private:
+    // Points [begin, end) of the current scan.
+    using Interval = std::pair<std::size_t, std::size_t>;
+
+    // Recomputes the direction table if the beam angles have changed.
+    void updateDirections(const std::vector<float> &angles);
+    // Splits the clusters of the current scan into intervals which are close to their chord.
+    bool split(std::chrono::steady_clock::time_point deadline);
+    // Merges neighbouring intervals on the same line.
+    bool merge(std::chrono::steady_clock::time_point deadline);
+    // Fits a line to the points of an interval.
+    LineSegment fit(const Interval &interval) const;
+    // Largest distance of a point of the interval to the given line.
+    float maxResidual(const Interval &interval, const LineSegment &line) const;
+
+    LineExtractionParams params_;
+
+    std::vector<float> angles_;
+    std::vector<float> cos_;
+    std::vector<float> sin_;
+
+    // Valid points of the current scan and the indices of their beams.
+    std::vector<float> xs_;
+    std::vector<float> ys_;
+    std::vector<uint32_t> beams_;
+
+    std::vector<Interval> stack_;
+    std::vector<Interval> intervals_;
+    std::vector<LineSegment> segments_;
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
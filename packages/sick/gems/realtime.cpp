@@ -0,0 +1,114 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    realtime.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "realtime.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+bool PinCurrentThread(const std::vector<int> &cpus, std::string &error) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      error = "invalid CPU " + std::to_string(cpu);
+      return false;
+    }
+    CPU_SET(cpu, &set);
+  }
+  const int result = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  if (result != 0) {
+    error = std::strerror(result);
+    return false;
+  }
+  return true;
+}
+
+bool SetCurrentThreadFifoPriority(int priority, std::string &error) {
+  if (priority < sched_get_priority_min(SCHED_FIFO) ||
+      priority > sched_get_priority_max(SCHED_FIFO)) {
+    error = "priority " + std::to_string(priority) + " is out of range";
+    return false;
+  }
+  sched_param param{};
+  param.sched_priority = priority;
+  const int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+  if (result != 0) {
+    error = std::strerror(result);
+    return false;
+  }
+  return true;
+}
+
+bool LockProcessMemory(std::string &error) {
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    error = std::strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+std::vector<int> CurrentThreadAffinity() {
+  std::vector<int> cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+  return cpus;
+}
+
+int CurrentThreadFifoPriority() {
+  int policy = 0;
+  sched_param param{};
+  if (pthread_getschedparam(pthread_self(), &policy, &param) != 0 ||
+      policy != SCHED_FIFO) {
+    return 0;
+  }
+  return param.sched_priority;
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
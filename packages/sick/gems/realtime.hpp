@@ -22,59 +22,42 @@
 
 // -- END LICENSE BLOCK ------------------------------------------------
 
+//----------------------------------------------------------------------
 //----------------------------------------------------------------------
 /*!
- * \file    Consumer.cpp
+ * \file    realtime.hpp
  *
- * \author  Martin Schulze <schulze@fzi.de>
- * \date    2020-04-15
+ * \author  agent <agent@local>
+ * \date    2026-10-19
  */
 //----------------------------------------------------------------------
 
-#include "Consumer.hpp"
+#pragma once
 
-#include <vector>
-#include <algorithm>
 #include <string>
-#include <sstream>
-#include <iterator>
-#include <iostream>
-
-#include <sick_safetyscanners_base/Types.h>
-
-#include "messages/tensor.hpp"
+#include <vector>
 
 namespace isaac
 {
 namespace sick_safetyscanners
 {
 
-void Consumer::start()
-{
-    LOG_INFO("Starting Consumer node");
-    tickOnMessage(rx_safety_scan());
-}
-
-void Consumer::stop()
-{
-    LOG_INFO("Stopping Consumer node");
-}
+// Helpers to reduce the scheduling jitter of the calling thread. All functions return false and
+// describe the reason in `error` if the setting could not be applied, e.g. because of missing
+// privileges (CAP_SYS_NICE, CAP_IPC_LOCK or a too low RLIMIT_RTPRIO / RLIMIT_MEMLOCK). Nothing is
+// changed in this case.
 
-void Consumer::tick()
-{
-    // Send FindMeCommand with a blink time of 5 seconds at tick 100 the first time and from thereon every 200 ticks.
-    if (getTickCount() % 200 == (0 + 100))
-    {
-        auto find_me_proto = tx_find_me_cmd().initProto();
-        find_me_proto.setBlinkTime(5);
-        tx_find_me_cmd().publish();
-    }
+// Restricts the calling thread to the given CPUs.
+bool PinCurrentThread(const std::vector<int> &cpus, std::string &error);
+// Switches the calling thread to SCHED_FIFO with the given priority in [1, 99].
+bool SetCurrentThreadFifoPriority(int priority, std::string &error);
+// Locks all current and future pages of the process into memory.
+bool LockProcessMemory(std::string &error);
 
-    auto proto = rx_safety_scan().getProto();
-    auto scan_number = proto.getHeader().getScanNumber();
-    auto n_beams = proto.getMeasurementData().getNumberOfBeams();
-    LOG_INFO("received scan# %d with %d beams", scan_number, n_beams);
-}
+// The CPUs the calling thread may run on.
+std::vector<int> CurrentThreadAffinity();
+// The SCHED_FIFO priority of the calling thread, 0 for other scheduling policies.
+int CurrentThreadFifoPriority();
 
-} // namespace sick_components
+} // namespace sick_safetyscanners
 } // namespace isaac
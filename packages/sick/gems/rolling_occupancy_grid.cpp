@@ -0,0 +1,300 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    rolling_occupancy_grid.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "rolling_occupancy_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+// Modulo which is non-negative also for negative dividends.
+inline int64_t PositiveModulo(int64_t value, int64_t divisor) {
+  const int64_t result = value % divisor;
+  return result < 0 ? result + divisor : result;
+}
+
+// Division which rounds towards negative infinity.
+inline int64_t FloorDivide(int64_t value, int64_t divisor) {
+  return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+inline int64_t ToCell(float position, float cell_size) {
+  return static_cast<int64_t>(std::floor(position / cell_size));
+}
+
+// Range [begin, end) of cells entering a window of the given size when its
+// origin moves along one axis. Empty if the origin does not move.
+void EnteringCells(int64_t origin, int64_t new_origin, int64_t size,
+                   int64_t &begin, int64_t &end) {
+  const int64_t shift = new_origin - origin;
+  if (std::abs(shift) >= size) {
+    begin = new_origin;
+    end = new_origin + size;
+  } else if (shift > 0) {
+    begin = origin + size;
+    end = new_origin + size;
+  } else {
+    begin = new_origin;
+    end = origin;
+  }
+}
+
+} // namespace
+
+RollingOccupancyGrid::RollingOccupancyGrid(int size, float cell_size)
+    : cell_size_(std::max(cell_size, 1e-3f)) {
+  tiles_ = std::max((size + kTileSize - 1) / kTileSize, 1);
+  size_ = tiles_ * kTileSize;
+  cells_.assign(static_cast<std::size_t>(size_) * size_, 0);
+  dirty_tiles_.assign(static_cast<std::size_t>(tiles_) * tiles_, 0);
+  origin_x_ = -size_ / 2;
+  origin_y_ = -size_ / 2;
+}
+
+void RollingOccupancyGrid::setLogOdds(int hit, int miss, int limit) {
+  limit_ = std::min(std::max(std::abs(limit), 1),
+                    static_cast<int>(std::numeric_limits<int8_t>::max()));
+  hit_ = std::min(std::abs(hit), limit_);
+  miss_ = -std::min(std::abs(miss), limit_);
+}
+
+void RollingOccupancyGrid::recenter(float x, float y) {
+  const int64_t new_origin_x = ToCell(x, cell_size_) - size_ / 2;
+  const int64_t new_origin_y = ToCell(y, cell_size_) - size_ / 2;
+
+  // Columns entering the window reuse the storage of the columns leaving it
+  int64_t begin_x = 0;
+  int64_t end_x = 0;
+  EnteringCells(origin_x_, new_origin_x, size_, begin_x, end_x);
+  clearColumns(begin_x, end_x);
+  origin_x_ = new_origin_x;
+
+  int64_t begin_y = 0;
+  int64_t end_y = 0;
+  EnteringCells(origin_y_, new_origin_y, size_, begin_y, end_y);
+  clearRows(begin_y, end_y);
+  origin_y_ = new_origin_y;
+}
+
+void RollingOccupancyGrid::insertScan(float sensor_x, float sensor_y,
+                                      float sensor_yaw,
+                                      const std::vector<float> &angles,
+                                      const std::vector<float> &ranges,
+                                      float invalid_range, float out_of_range,
+                                      float max_range) {
+  updateDirections(angles);
+
+  const int64_t x0 = ToCell(sensor_x, cell_size_);
+  const int64_t y0 = ToCell(sensor_y, cell_size_);
+  if (!contains(x0, y0)) {
+    return;
+  }
+
+  // Rays longer than the diagonal of the grid leave it in any case
+  const float max_length =
+      std::min(max_range, 1.5f * static_cast<float>(size_) * cell_size_);
+  const float cos_yaw = std::cos(sensor_yaw);
+  const float sin_yaw = std::sin(sensor_yaw);
+
+  const std::size_t n_beams = std::min(ranges.size(), cos_.size());
+  for (std::size_t i = 0; i < n_beams; i++) {
+    const float range = ranges[i];
+    if (!(range >= invalid_range)) {
+      continue;
+    }
+    const bool hit = range < out_of_range && range <= max_length;
+    const float length = hit ? range : max_length;
+
+    const float direction_x = cos_[i] * cos_yaw - sin_[i] * sin_yaw;
+    const float direction_y = sin_[i] * cos_yaw + cos_[i] * sin_yaw;
+    const int64_t x1 = ToCell(sensor_x + length * direction_x, cell_size_);
+    const int64_t y1 = ToCell(sensor_y + length * direction_y, cell_size_);
+    castRay(x0, y0, x1, y1, hit);
+  }
+}
+
+void RollingOccupancyGrid::dirtyRegions(
+    std::vector<CellRegion> &regions) const {
+  regions.clear();
+  if (dirty_tile_count_ == 0) {
+    return;
+  }
+  // The window is not aligned to the tiles, so tiles along its border are cut
+  const CellRegion window = this->window();
+  for (int64_t tile_y = FloorDivide(window.min_y, kTileSize);
+       tile_y * kTileSize < window.max_y; tile_y++) {
+    for (int64_t tile_x = FloorDivide(window.min_x, kTileSize);
+         tile_x * kTileSize < window.max_x; tile_x++) {
+      CellRegion region{std::max(tile_x * kTileSize, window.min_x),
+                        std::max(tile_y * kTileSize, window.min_y),
+                        std::min((tile_x + 1) * kTileSize, window.max_x),
+                        std::min((tile_y + 1) * kTileSize, window.max_y)};
+      if (dirty_tiles_[tileIndex(region.min_x, region.min_y)]) {
+        regions.push_back(region);
+      }
+    }
+  }
+}
+
+void RollingOccupancyGrid::clearDirtyTiles() {
+  std::fill(dirty_tiles_.begin(), dirty_tiles_.end(), 0);
+  dirty_tile_count_ = 0;
+}
+
+CellRegion RollingOccupancyGrid::window() const {
+  return CellRegion{origin_x_, origin_y_, origin_x_ + size_, origin_y_ + size_};
+}
+
+void RollingOccupancyGrid::copyRegion(const CellRegion &region,
+                                      int8_t *log_odds) const {
+  std::size_t k = 0;
+  for (int64_t y = region.min_y; y < region.max_y; y++) {
+    for (int64_t x = region.min_x; x < region.max_x; x++) {
+      log_odds[k++] = at(x, y);
+    }
+  }
+}
+
+int8_t RollingOccupancyGrid::at(int64_t x, int64_t y) const {
+  return contains(x, y) ? cells_[index(x, y)] : 0;
+}
+
+std::size_t RollingOccupancyGrid::tileIndex(int64_t x, int64_t y) const {
+  const int64_t u = PositiveModulo(x, size_);
+  const int64_t v = PositiveModulo(y, size_);
+  return static_cast<std::size_t>((v / kTileSize) * tiles_ + u / kTileSize);
+}
+
+std::size_t RollingOccupancyGrid::index(int64_t x, int64_t y) const {
+  const int64_t u = PositiveModulo(x, size_);
+  const int64_t v = PositiveModulo(y, size_);
+  const int64_t tile = (v / kTileSize) * tiles_ + u / kTileSize;
+  return static_cast<std::size_t>(tile * kTileSize * kTileSize +
+                                  (v % kTileSize) * kTileSize + u % kTileSize);
+}
+
+bool RollingOccupancyGrid::contains(int64_t x, int64_t y) const {
+  return x >= origin_x_ && x < origin_x_ + size_ && y >= origin_y_ &&
+         y < origin_y_ + size_;
+}
+
+void RollingOccupancyGrid::update(int64_t x, int64_t y, int delta) {
+  int8_t &cell = cells_[index(x, y)];
+  const int value = std::min(std::max(cell + delta, -limit_), limit_);
+  if (value != cell) {
+    cell = static_cast<int8_t>(value);
+    markDirty(tileIndex(x, y));
+  }
+}
+
+void RollingOccupancyGrid::castRay(int64_t x0, int64_t y0, int64_t x1,
+                                   int64_t y1, bool hit) {
+  const int64_t dx = std::abs(x1 - x0);
+  const int64_t dy = -std::abs(y1 - y0);
+  const int64_t step_x = x0 < x1 ? 1 : -1;
+  const int64_t step_y = y0 < y1 ? 1 : -1;
+  int64_t error = dx + dy;
+  int64_t x = x0;
+  int64_t y = y0;
+
+  while (x != x1 || y != y1) {
+    // The ray starts inside the convex window, so it never re-enters it
+    if (!contains(x, y)) {
+      return;
+    }
+    update(x, y, miss_);
+    const int64_t error2 = 2 * error;
+    if (error2 >= dy) {
+      error += dy;
+      x += step_x;
+    }
+    if (error2 <= dx) {
+      error += dx;
+      y += step_y;
+    }
+  }
+  if (contains(x1, y1)) {
+    update(x1, y1, hit ? hit_ : miss_);
+  }
+}
+
+void RollingOccupancyGrid::clearColumns(int64_t begin, int64_t end) {
+  for (int64_t x = begin; x < end; x++) {
+    for (int64_t y = origin_y_; y < origin_y_ + size_; y++) {
+      cells_[index(x, y)] = 0;
+    }
+    for (int64_t y = origin_y_; y < origin_y_ + size_; y += kTileSize) {
+      markDirty(tileIndex(x, y));
+    }
+  }
+}
+
+void RollingOccupancyGrid::clearRows(int64_t begin, int64_t end) {
+  for (int64_t y = begin; y < end; y++) {
+    for (int64_t x = origin_x_; x < origin_x_ + size_; x++) {
+      cells_[index(x, y)] = 0;
+    }
+    for (int64_t x = origin_x_; x < origin_x_ + size_; x += kTileSize) {
+      markDirty(tileIndex(x, y));
+    }
+  }
+}
+
+void RollingOccupancyGrid::updateDirections(const std::vector<float> &angles) {
+  if (angles == angles_) {
+    return;
+  }
+  angles_ = angles;
+  cos_.resize(angles.size());
+  sin_.resize(angles.size());
+  for (std::size_t i = 0; i < angles.size(); i++) {
+    cos_[i] = std::cos(angles[i]);
+    sin_[i] = std::sin(angles[i]);
+  }
+}
+
+void RollingOccupancyGrid::markDirty(std::size_t tile) {
+  if (!dirty_tiles_[tile]) {
+    dirty_tiles_[tile] = 1;
+    dirty_tile_count_++;
+  }
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
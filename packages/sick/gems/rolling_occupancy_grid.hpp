@@ -0,0 +1,146 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    rolling_occupancy_grid.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// A square region of grid cells given in world cell indices (cell i covers [i, i+1) * cell_size).
+struct CellRegion
+{
+    int64_t min_x{0};
+    int64_t min_y{0};
+    // Exclusive upper bounds
+    int64_t max_x{0};
+    int64_t max_y{0};
+
+    bool empty() const { return max_x <= min_x || max_y <= min_y; }
+    int64_t width() const { return empty() ? 0 : max_x - min_x; }
+    int64_t height() const { return empty() ? 0 : max_y - min_y; }
+};
+
+// A robot-centred occupancy grid of fixed size which moves along with the sensor. Cells store
+// clamped log-odds: 0 is unknown, positive values are occupied and negative values are free.
+//
+// The cells are stored in tiles of 16x16 cells which are addressed modulo the grid size. Moving the
+// grid therefore only clears the rows and columns which enter the window instead of copying
+// memory, and rays touch a few compact tiles instead of long rows. Scans are inserted with
+// Bresenham ray casting from the sensor cell to the end point of each beam. Changes are tracked
+// per tile, so only the tiles touched by a scan have to be published.
+class RollingOccupancyGrid
+{
+public:
+    // Edge length of a tile [cells].
+    static constexpr int kTileSize = 16;
+
+    // Size of the grid [cells] is rounded up to a multiple of kTileSize. Cell size is in [meters].
+    RollingOccupancyGrid(int size, float cell_size);
+
+    // Sets the log-odds increments for hits and misses and the absolute limit of the log-odds.
+    void setLogOdds(int hit, int miss, int limit);
+
+    // Moves the grid such that the given position [meters] is in its centre. Cells leaving the
+    // grid are forgotten, cells entering it are unknown and their tiles are marked dirty.
+    void recenter(float x, float y);
+
+    // Inserts a scan taken at the given sensor pose [meters, radians]. Beams with a range below
+    // invalid_range are skipped, beams at or above out_of_range mark free space up to max_range.
+    void insertScan(float sensor_x, float sensor_y, float sensor_yaw,
+                    const std::vector<float> &angles, const std::vector<float> &ranges,
+                    float invalid_range, float out_of_range, float max_range);
+
+    // Fills regions with the parts of the window covered by tiles which changed since the last
+    // call of clearDirtyTiles. Tiles cut by the border of the window yield up to four regions.
+    void dirtyRegions(std::vector<CellRegion> &regions) const;
+    // Number of tiles which changed since the last call of clearDirtyTiles.
+    int dirtyTileCount() const { return dirty_tile_count_; }
+    void clearDirtyTiles();
+    // Region currently covered by the grid.
+    CellRegion window() const;
+
+    // Copies the log-odds of the given region in row-major order into a buffer of
+    // width * height cells. Cells outside the grid are unknown.
+    void copyRegion(const CellRegion &region, int8_t *log_odds) const;
+
+    // Log-odds of the given world cell. Cells outside the grid are unknown.
+    int8_t at(int64_t x, int64_t y) const;
+
+    int size() const { return size_; }
+    float cellSize() const { return cell_size_; }
+
+private:
+    // Index into the tiled storage for a world cell inside the window.
+    std::size_t index(int64_t x, int64_t y) const;
+    // Index of the tile which stores the given world cell.
+    std::size_t tileIndex(int64_t x, int64_t y) const;
+    bool contains(int64_t x, int64_t y) const;
+    // Adds the given delta to a cell and clamps the result.
+    void update(int64_t x, int64_t y, int delta);
+    // Marks the cells from (x0, y0) to (x1, y1) as free and the end cell as hit if requested.
+    void castRay(int64_t x0, int64_t y0, int64_t x1, int64_t y1, bool hit);
+    // Resets all cells in the given rows or columns to unknown and marks their tiles dirty.
+    void clearColumns(int64_t begin, int64_t end);
+    void clearRows(int64_t begin, int64_t end);
+    // Recomputes the direction table if the beam angles have changed.
+    void updateDirections(const std::vector<float> &angles);
+    void markDirty(std::size_t tile);
+
+    int size_;
+    int tiles_;
+    float cell_size_;
+    int hit_{20};
+    int miss_{-5};
+    int limit_{100};
+
+    // World cell index of the lower left cell of the window.
+    int64_t origin_x_{0};
+    int64_t origin_y_{0};
+    // One flag per tile of the storage.
+    std::vector<uint8_t> dirty_tiles_;
+    int dirty_tile_count_{0};
+    std::vector<int8_t> cells_;
+
+    // Beam angles of the last scan and their unit direction vectors in the sensor frame.
+    std::vector<float> angles_;
+    std::vector<float> cos_;
+    std::vector<float> sin_;
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,190 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    scan_alignment.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "scan_alignment.hpp"
+
+#include <algorithm>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+constexpr int64_t kMillisecondsPerDay = 86400000;
+constexpr int64_t kNanosecondsPerMillisecond = 1000000;
+
+// An offset above the current estimate moves it by 1/kOffsetRelaxation of the difference. At 40
+// scans per second this follows a drift of the sensor clock within a few seconds.
+constexpr int64_t kOffsetRelaxation = 64;
+
+int64_t Distance(int64_t a, int64_t b) { return a > b ? a - b : b - a; }
+
+} // namespace
+
+int64_t SensorTime(uint16_t date, uint32_t time) {
+  return (static_cast<int64_t>(date) * kMillisecondsPerDay + time) *
+         kNanosecondsPerMillisecond;
+}
+
+void ScanAlignmentBuffer::configure(std::size_t sensor_count,
+                                    std::size_t ring_size, int64_t tolerance,
+                                    TimeSource time_source) {
+  ring_size_ = std::max<std::size_t>(ring_size, 1);
+  tolerance_ = std::max<int64_t>(tolerance, 0);
+  time_source_ = time_source;
+  sensors_.assign(sensor_count, Sensor());
+  for (auto &sensor : sensors_) {
+    sensor.ring.resize(ring_size_);
+  }
+  spread_ = 0;
+  match_count_ = 0;
+}
+
+int ScanAlignmentBuffer::push(std::size_t sensor_index,
+                              const ScanStamp &stamp) {
+  Sensor &sensor = sensors_[sensor_index];
+  if (sensor.pushed > 0) {
+    const Entry &last = sensor.ring[(sensor.pushed - 1) % ring_size_];
+    if (stamp.scan_number == last.stamp.scan_number) {
+      sensor.duplicates++;
+      return -1;
+    }
+    if (stamp.scan_number < last.stamp.scan_number) {
+      // The sensor restarted, neither its scans nor its clock are comparable
+      // to the previous ones.
+      reset(sensor);
+    } else {
+      sensor.lost += stamp.scan_number - last.stamp.scan_number - 1;
+    }
+  }
+
+  Entry entry;
+  entry.stamp = stamp;
+  if (time_source_ == TimeSource::kSensor) {
+    const int64_t offset = stamp.acqtime - stamp.sensor_time;
+    if (!sensor.has_offset || offset < sensor.offset) {
+      sensor.offset = offset;
+      sensor.has_offset = true;
+    } else {
+      sensor.offset += (offset - sensor.offset) / kOffsetRelaxation;
+    }
+    entry.time = stamp.sensor_time + sensor.offset;
+  } else {
+    entry.time = stamp.acqtime;
+  }
+  entry.sequence = ++sensor.pushed;
+
+  const int slot = static_cast<int>((entry.sequence - 1) % ring_size_);
+  sensor.ring[slot] = entry;
+  return slot;
+}
+
+bool ScanAlignmentBuffer::match(std::vector<int> &slots) {
+  if (sensors_.empty()) {
+    return false;
+  }
+  slots.resize(sensors_.size());
+
+  // Every scan of the first sensor is a candidate, starting with the newest.
+  // Since the tolerance is meant to be smaller than half a scan period, the
+  // scan closest to the candidate is the only one of another sensor which can
+  // be part of its set.
+  const Sensor &reference = sensors_.front();
+  const uint64_t oldest =
+      reference.pushed > ring_size_ ? reference.pushed - ring_size_ : 0;
+  for (uint64_t sequence = reference.pushed;
+       sequence > std::max(oldest, reference.taken); sequence--) {
+    const Entry &candidate = reference.ring[(sequence - 1) % ring_size_];
+    int64_t min_time = candidate.time;
+    int64_t max_time = candidate.time;
+    bool complete = true;
+    for (std::size_t i = 1; i < sensors_.size(); i++) {
+      const Entry *entry = closest(sensors_[i], candidate.time);
+      if (entry == nullptr) {
+        complete = false;
+        break;
+      }
+      min_time = std::min(min_time, entry->time);
+      max_time = std::max(max_time, entry->time);
+      slots[i] = static_cast<int>((entry->sequence - 1) % ring_size_);
+    }
+    if (!complete || max_time - min_time > tolerance_) {
+      continue;
+    }
+
+    slots[0] = static_cast<int>((candidate.sequence - 1) % ring_size_);
+    for (std::size_t i = 0; i < sensors_.size(); i++) {
+      sensors_[i].taken = sensors_[i].ring[slots[i]].sequence;
+    }
+    spread_ = max_time - min_time;
+    match_count_++;
+    return true;
+  }
+  return false;
+}
+
+const ScanStamp &ScanAlignmentBuffer::stamp(std::size_t sensor,
+                                            int slot) const {
+  return sensors_[sensor].ring[slot].stamp;
+}
+
+int64_t ScanAlignmentBuffer::time(std::size_t sensor, int slot) const {
+  return sensors_[sensor].ring[slot].time;
+}
+
+void ScanAlignmentBuffer::reset(Sensor &sensor) {
+  sensor.pushed = 0;
+  sensor.taken = 0;
+  sensor.offset = 0;
+  sensor.has_offset = false;
+}
+
+const ScanAlignmentBuffer::Entry *
+ScanAlignmentBuffer::closest(const Sensor &sensor, int64_t time) const {
+  const uint64_t oldest =
+      sensor.pushed > ring_size_ ? sensor.pushed - ring_size_ : 0;
+  const Entry *best = nullptr;
+  for (uint64_t sequence = sensor.pushed;
+       sequence > std::max(oldest, sensor.taken); sequence--) {
+    const Entry &entry = sensor.ring[(sequence - 1) % ring_size_];
+    if (best == nullptr ||
+        Distance(entry.time, time) < Distance(best->time, time)) {
+      best = &entry;
+    }
+  }
+  return best;
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,141 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    scan_alignment.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Identification and times of a scan as used for the alignment.
+struct ScanStamp
+{
+    uint32_t scan_number{0};
+    // Timestamp of the data header [nanoseconds, sensor clock]
+    int64_t sensor_time{0};
+    // Receive time [nanoseconds, application clock]
+    int64_t acqtime{0};
+};
+
+// Converts the timestamp of a data header (days since 1.1.1972 and milliseconds since midnight)
+// to nanoseconds.
+int64_t SensorTime(uint16_t date, uint32_t time);
+
+// Keeps the latest scans of several sensors in rings of a fixed size and finds the newest set
+// with one scan per sensor whose times lie within a tolerance. Every scan is used in at most one
+// set and the scans of consecutive sets are strictly increasing per sensor.
+//
+// With TimeSource::kSensor the header timestamps are mapped to the application clock with a
+// per-sensor offset. The offset follows the smallest observed transport delay immediately and
+// larger ones only slowly, so network and scheduling jitter of the receive time does not affect
+// the alignment while clock drift is still tracked. Scan numbers are used to drop duplicates, to
+// count lost scans and to detect restarts of a sensor, which clear its ring.
+class ScanAlignmentBuffer
+{
+public:
+    enum class TimeSource
+    {
+        kSensor,
+        kAcqtime
+    };
+
+    // Number of sensors, ring size per sensor and maximum difference between the times of the
+    // scans of a set [nanoseconds]. Clears all rings.
+    void configure(std::size_t sensor_count, std::size_t ring_size, int64_t tolerance,
+                   TimeSource time_source);
+
+    // Adds a scan and returns the ring slot it occupies, or -1 if the scan was dropped as a
+    // duplicate. The slot of the oldest scan of the sensor is reused once its ring is full.
+    int push(std::size_t sensor, const ScanStamp &stamp);
+    // Finds the newest set of scans which are within the tolerance and newer than the scans of the
+    // previous set. On success the ring slot of every sensor is written to `slots` and the set is
+    // marked as taken.
+    bool match(std::vector<int> &slots);
+
+    // Stamp and aligned time [nanoseconds, application clock] of the scan in the given slot.
+    const ScanStamp &stamp(std::size_t sensor, int slot) const;
+    int64_t time(std::size_t sensor, int slot) const;
+    // Difference between the newest and the oldest time of the last set [nanoseconds].
+    int64_t spread() const { return spread_; }
+
+    std::size_t sensorCount() const { return sensors_.size(); }
+    std::size_t ringSize() const { return ring_size_; }
+    // Scans missing according to the scan numbers and scans dropped as duplicates.
+    uint64_t lostScans(std::size_t sensor) const { return sensors_[sensor].lost; }
+    uint64_t duplicateScans(std::size_t sensor) const { return sensors_[sensor].duplicates; }
+    // Number of sets found so far.
+    uint64_t matchCount() const { return match_count_; }
+
+private:
+    struct Entry
+    {
+        ScanStamp stamp;
+        int64_t time{0};
+        // Number of the push which stored the entry, starting at 1.
+        uint64_t sequence{0};
+    };
+
+    struct Sensor
+    {
+        std::vector<Entry> ring;
+        uint64_t pushed{0};
+        // Sequence of the scan used in the last set.
+        uint64_t taken{0};
+        int64_t offset{0};
+        bool has_offset{false};
+        uint64_t lost{0};
+        uint64_t duplicates{0};
+    };
+
+    // Removes all scans and the clock offset of a sensor.
+    void reset(Sensor &sensor);
+    // Returns the entry of a sensor which is newer than its scan of the last set and whose time is
+    // closest to the given one, or nullptr if there is none.
+    const Entry *closest(const Sensor &sensor, int64_t time) const;
+
+    std::size_t ring_size_{1};
+    int64_t tolerance_{0};
+    TimeSource time_source_{TimeSource::kSensor};
+    std::vector<Sensor> sensors_;
+    int64_t spread_{0};
+    uint64_t match_count_{0};
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,90 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    scan_batch.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "scan_batch.hpp"
+
+#include <algorithm>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+bool ScanBatchLayout::operator==(const ScanBatchLayout &other) const {
+  return serial_number == other.serial_number && channel == other.channel &&
+         multiplication_factor == other.multiplication_factor &&
+         scan_time == other.scan_time && start_angle == other.start_angle &&
+         angular_resolution == other.angular_resolution &&
+         number_of_beams == other.number_of_beams;
+}
+
+void ScanBatch::configure(std::size_t max_scans, int64_t max_latency) {
+  max_scans_ = std::max<std::size_t>(max_scans, 1);
+  max_latency_ = std::max<int64_t>(max_latency, 0);
+  entries_.reserve(max_scans_);
+}
+
+void ScanBatch::append(const ScanBatchLayout &layout,
+                       const ScanBatchEntry &entry, uint16_t *&distances,
+                       uint8_t *&reflectivities, uint8_t *&status) {
+  if (entries_.empty()) {
+    layout_ = layout;
+  }
+  entries_.push_back(entry);
+
+  const std::size_t offset = distances_.size();
+  const std::size_t size = offset + layout_.number_of_beams;
+  distances_.resize(size);
+  reflectivities_.resize(size);
+  status_.resize(size);
+  distances = distances_.data() + offset;
+  reflectivities = reflectivities_.data() + offset;
+  status = status_.data() + offset;
+}
+
+bool ScanBatch::due(int64_t now) const {
+  if (entries_.empty()) {
+    return false;
+  }
+  return entries_.size() >= max_scans_ ||
+         (max_latency_ > 0 && now - entries_.front().acqtime >= max_latency_);
+}
+
+void ScanBatch::clear() {
+  entries_.clear();
+  distances_.clear();
+  reflectivities_.clear();
+  status_.clear();
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,115 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    scan_batch.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Values which all scans of a batch have in common.
+struct ScanBatchLayout
+{
+    uint32_t serial_number{0};
+    uint8_t channel{0};
+    uint16_t multiplication_factor{0};
+    uint16_t scan_time{0};
+    // [radians]
+    float start_angle{0.0f};
+    float angular_resolution{0.0f};
+    uint16_t number_of_beams{0};
+
+    bool operator==(const ScanBatchLayout &other) const;
+    bool operator!=(const ScanBatchLayout &other) const { return !(*this == other); }
+};
+
+// Per-scan values of a batch.
+struct ScanBatchEntry
+{
+    uint32_t scan_number{0};
+    uint32_t sequence_number{0};
+    uint16_t timestamp_date{0};
+    uint32_t timestamp_time{0};
+    // Receive time [nanoseconds]
+    int64_t acqtime{0};
+};
+
+// Collects consecutive scans with the same layout in columns until the batch is full or its
+// oldest scan exceeds the latency budget. The columns keep their capacity when the batch is
+// cleared, so no memory is allocated once the first batch has been filled.
+class ScanBatch
+{
+public:
+    // Maximum number of scans per batch and maximum age of the oldest scan [nanoseconds] before
+    // the batch is due. An age of 0 disables the latency limit.
+    void configure(std::size_t max_scans, int64_t max_latency);
+
+    // True if a scan with the given layout can be appended. A scan with a different layout
+    // requires the batch to be published and cleared first.
+    bool accepts(const ScanBatchLayout &layout) const { return empty() || layout == layout_; }
+    // Appends a scan and returns pointers to its beam columns with layout.number_of_beams
+    // entries each. They are valid until the next call to append or clear.
+    void append(const ScanBatchLayout &layout, const ScanBatchEntry &entry, uint16_t *&distances,
+                uint8_t *&reflectivities, uint8_t *&status);
+    // True if the batch is full or its oldest scan is older than the latency budget at the
+    // given time [nanoseconds].
+    bool due(int64_t now) const;
+    // Removes all scans.
+    void clear();
+
+    bool empty() const { return entries_.empty(); }
+    std::size_t size() const { return entries_.size(); }
+    const ScanBatchLayout &layout() const { return layout_; }
+    const std::vector<ScanBatchEntry> &entries() const { return entries_; }
+    const std::vector<uint16_t> &distances() const { return distances_; }
+    const std::vector<uint8_t> &reflectivities() const { return reflectivities_; }
+    const std::vector<uint8_t> &status() const { return status_; }
+
+private:
+    std::size_t max_scans_{1};
+    int64_t max_latency_{0};
+    ScanBatchLayout layout_;
+    std::vector<ScanBatchEntry> entries_;
+    std::vector<uint16_t> distances_;
+    std::vector<uint8_t> reflectivities_;
+    std::vector<uint8_t> status_;
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
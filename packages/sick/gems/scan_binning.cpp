@@ -0,0 +1,80 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    scan_binning.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "scan_binning.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "packages/sick/gems/shared_scan_ring.hpp"
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+void MinRangeBinning::configure(int bins) { bins_.resize(std::max(bins, 1)); }
+
+void MinRangeBinning::begin(float angle_min, float angle_max) {
+  angle_min_ = angle_min;
+  const float span = angle_max - angle_min;
+  bin_width_ = span > 0.0f ? span / static_cast<float>(bins_.size()) : 1.0f;
+  std::fill(bins_.begin(), bins_.end(),
+            std::numeric_limits<float>::infinity());
+}
+
+void MinRangeBinning::add(float angle, float range, uint8_t status) {
+  if (!(status & kBeamValid) || (status & (kBeamInfinite | kBeamGlare))) {
+    return;
+  }
+  const int last = static_cast<int>(bins_.size()) - 1;
+  const int bin = std::min(
+      std::max(static_cast<int>((angle - angle_min_) / bin_width_), 0), last);
+  bins_[bin] = std::min(bins_[bin], range);
+}
+
+void MinRangeBinning::finish() {
+  angles_.clear();
+  ranges_.clear();
+  for (std::size_t i = 0; i < bins_.size(); i++) {
+    if (std::isinf(bins_[i])) {
+      continue;
+    }
+    angles_.push_back(angle_min_ +
+                      (static_cast<float>(i) + 0.5f) * bin_width_);
+    ranges_.push_back(bins_[i]);
+  }
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
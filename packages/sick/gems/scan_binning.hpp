@@ -0,0 +1,73 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    scan_binning.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Reduces a scan to a fixed number of angular bins for visualization. Every bin keeps the
+// smallest range of its beams, so thin obstacles stay visible. Bins without any measured beam are
+// left out.
+class MinRangeBinning
+{
+public:
+    // Sets the number of bins.
+    void configure(int bins);
+    // Starts a scan covering [angle_min, angle_max] [radians].
+    void begin(float angle_min, float angle_max);
+    // Adds a beam of the current scan with its status bits, see SharedScanBeamStatus. Beams which
+    // are not valid, infinite or glare are skipped, since they do not measure an obstacle.
+    void add(float angle, float range, uint8_t status);
+    // Computes the angles (bin centres) and ranges of all bins which received a beam.
+    void finish();
+
+    const std::vector<float> &angles() const { return angles_; }
+    const std::vector<float> &ranges() const { return ranges_; }
+
+private:
+    float angle_min_{0.0f};
+    float bin_width_{1.0f};
+    std::vector<float> bins_;
+    std::vector<float> angles_;
+    std::vector<float> ranges_;
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,392 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    scan_datagram.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "scan_datagram.hpp"
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+#include <sick_safetyscanners_base/data_processing/ParseApplicationData.h>
+#include <sick_safetyscanners_base/data_processing/ParseDataHeader.h>
+#include <sick_safetyscanners_base/data_processing/ParseDerivedValues.h>
+#include <sick_safetyscanners_base/data_processing/ParseGeneralSystemState.h>
+#include <sick_safetyscanners_base/data_processing/ParseIntrusionData.h>
+#include <sick_safetyscanners_base/data_processing/ParseMeasurementData.h>
+#include <sick_safetyscanners_base/datastructure/PacketBuffer.h>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+// Largest possible UDP payload
+constexpr std::size_t kMaxPacketSize = 65536;
+
+// Offsets in the datagram header
+constexpr std::size_t kTotalLengthOffset = 8;
+constexpr std::size_t kIdentificationOffset = 12;
+constexpr std::size_t kFragmentOffsetOffset = 16;
+
+// Every beam of the measurement data block consists of the distance (uint16),
+// the reflectivity (uint8) and the status bits (uint8). The beams follow the
+// number of beams (uint32).
+constexpr std::size_t kBeamsOffset = 4;
+constexpr std::size_t kBeamSize = 4;
+constexpr uint8_t kValidBit = 1 << 0;
+constexpr uint8_t kInfiniteBit = 1 << 1;
+constexpr uint8_t kGlareBit = 1 << 2;
+constexpr uint8_t kReflectorBit = 1 << 3;
+constexpr uint8_t kContaminationBit = 1 << 4;
+constexpr uint8_t kContaminationWarningBit = 1 << 5;
+constexpr uint8_t kStatusBits = kValidBit | kInfiniteBit | kGlareBit |
+                                kReflectorBit | kContaminationBit |
+                                kContaminationWarningBit;
+
+// The sensor sends all values in little endian byte order.
+inline uint16_t ReadUint16(const uint8_t *data) {
+  return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+inline uint32_t ReadUint32(const uint8_t *data) {
+  return static_cast<uint32_t>(data[0]) |
+         (static_cast<uint32_t>(data[1]) << 8) |
+         (static_cast<uint32_t>(data[2]) << 16) |
+         (static_cast<uint32_t>(data[3]) << 24);
+}
+
+} // namespace
+
+bool ScanDatagramAssembler::addPacket(const uint8_t *packet, std::size_t size) {
+  if (size <= kDatagramHeaderSize) {
+    return false;
+  }
+  const uint32_t total_length = ReadUint32(packet + kTotalLengthOffset);
+  const uint32_t identification = ReadUint32(packet + kIdentificationOffset);
+  const uint32_t fragment_offset = ReadUint32(packet + kFragmentOffsetOffset);
+  const std::size_t fragment_size = size - kDatagramHeaderSize;
+  const std::size_t fragment_end =
+      static_cast<std::size_t>(fragment_offset) + fragment_size;
+  if (total_length > kMaxPayloadSize || fragment_end > total_length) {
+    return false;
+  }
+
+  if (!active_ || identification != identification_ ||
+      total_length != payload_.size()) {
+    identification_ = identification;
+    payload_.resize(total_length);
+    fragments_.clear();
+    received_ = 0;
+    active_ = true;
+  }
+  // Only the received bytes are counted, so a duplicated fragment must not
+  // stand in for a missing one
+  for (const Fragment &fragment : fragments_) {
+    if (fragment_offset < fragment.end && fragment_end > fragment.begin) {
+      return false;
+    }
+  }
+  fragments_.push_back(Fragment{fragment_offset, fragment_end});
+  std::memcpy(payload_.data() + fragment_offset, packet + kDatagramHeaderSize,
+              fragment_size);
+  received_ += fragment_size;
+  if (received_ < payload_.size()) {
+    return false;
+  }
+  active_ = false;
+  return true;
+}
+
+ScanDatagramReceiver::~ScanDatagramReceiver() { close(); }
+
+bool ScanDatagramReceiver::open(uint16_t port) {
+  close();
+  fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd_ < 0) {
+    return false;
+  }
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(port);
+  socklen_t length = sizeof(address);
+  if (::bind(fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) !=
+          0 ||
+      ::getsockname(fd_, reinterpret_cast<sockaddr *>(&address), &length) !=
+          0) {
+    close();
+    return false;
+  }
+  port_ = ntohs(address.sin_port);
+  packet_.resize(kMaxPacketSize);
+  return true;
+}
+
+void ScanDatagramReceiver::close() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+  fd_ = -1;
+  port_ = 0;
+}
+
+int ScanDatagramReceiver::setReceiveBufferSize(int size) {
+  // SO_RCVBUFFORCE ignores rmem_max but requires privileges
+  if (::setsockopt(fd_, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) != 0 &&
+      ::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) != 0) {
+    return -1;
+  }
+  int effective = 0;
+  socklen_t length = sizeof(effective);
+  if (::getsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &effective, &length) != 0) {
+    return -1;
+  }
+  // The kernel doubles the requested size to account for bookkeeping
+  return effective / 2;
+}
+
+bool ScanDatagramReceiver::receive(std::chrono::milliseconds timeout) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (true) {
+    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    pollfd descriptor{fd_, POLLIN, 0};
+    if (::poll(&descriptor, 1, std::max<int>(remaining.count(), 0)) <= 0) {
+      return false;
+    }
+    const ssize_t size = ::recv(fd_, packet_.data(), packet_.size(), 0);
+    if (size > 0 &&
+        assembler_.addPacket(packet_.data(), static_cast<std::size_t>(size))) {
+      return true;
+    }
+  }
+}
+
+void WriteScanDatagramCapture(std::ostream &stream,
+                              const std::vector<uint8_t> &payload) {
+  const uint32_t size = payload.size();
+  const uint8_t size_bytes[4] = {
+      static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8),
+      static_cast<uint8_t>(size >> 16), static_cast<uint8_t>(size >> 24)};
+  stream.write(reinterpret_cast<const char *>(size_bytes), sizeof(size_bytes));
+  stream.write(reinterpret_cast<const char *>(payload.data()), payload.size());
+}
+
+bool ReadScanDatagramCapture(std::istream &stream,
+                             std::vector<uint8_t> &payload) {
+  uint8_t size_bytes[4];
+  if (!stream.read(reinterpret_cast<char *>(size_bytes), sizeof(size_bytes))) {
+    return false;
+  }
+  const uint32_t size = ReadUint32(size_bytes);
+  if (size > ScanDatagramAssembler::kMaxPayloadSize) {
+    return false;
+  }
+  payload.resize(size);
+  return static_cast<bool>(
+      stream.read(reinterpret_cast<char *>(payload.data()), payload.size()));
+}
+
+sick::datastructure::Data ParseScanDatagram(const std::vector<uint8_t> &payload) {
+  const sick::datastructure::PacketBuffer buffer(payload);
+  sick::datastructure::Data data;
+
+  // Same order as in sick::data_processing::ParseData, later blocks depend on
+  // the header and the derived values.
+  sick::data_processing::ParseDataHeader header_parser;
+  data.setDataHeaderPtr(std::make_shared<sick::datastructure::DataHeader>(
+      header_parser.parseUDPSequence(buffer, data)));
+  sick::data_processing::ParseDerivedValues derived_values_parser;
+  data.setDerivedValuesPtr(std::make_shared<sick::datastructure::DerivedValues>(
+      derived_values_parser.parseUDPSequence(buffer, data)));
+  sick::data_processing::ParseGeneralSystemState system_state_parser;
+  data.setGeneralSystemStatePtr(
+      std::make_shared<sick::datastructure::GeneralSystemState>(
+          system_state_parser.parseUDPSequence(buffer, data)));
+  auto measurement_data =
+      std::make_shared<sick::datastructure::MeasurementData>();
+  measurement_data->setIsEmpty(true);
+  data.setMeasurementDataPtr(measurement_data);
+  sick::data_processing::ParseIntrusionData intrusion_parser;
+  data.setIntrusionDataPtr(std::make_shared<sick::datastructure::IntrusionData>(
+      intrusion_parser.parseUDPSequence(buffer, data)));
+  sick::data_processing::ParseApplicationData application_parser;
+  data.setApplicationDataPtr(
+      std::make_shared<sick::datastructure::ApplicationData>(
+          application_parser.parseUDPSequence(buffer, data)));
+  return data;
+}
+
+void ScanBeams::resize(std::size_t size) {
+  angles.resize(size);
+  distances.resize(size);
+  reflectivities.resize(size);
+  status.resize(size);
+}
+
+void DecodeScanBeams(const std::vector<uint8_t> &payload,
+                     const sick::datastructure::Data &data, float angle_offset,
+                     ScanBeams &beams) {
+  beams.resize(0);
+  // Same preconditions as sick::data_processing::ParseMeasurementData
+  const auto &header = *data.getDataHeaderPtr();
+  const auto &derived_values = *data.getDerivedValuesPtr();
+  if (header.isEmpty() || derived_values.isEmpty() ||
+      (header.getMeasurementDataBlockOffset() == 0 &&
+       header.getMeasurementDataBlockSize() == 0)) {
+    return;
+  }
+  const std::size_t block_offset = header.getMeasurementDataBlockOffset();
+  if (block_offset + kBeamsOffset > payload.size()) {
+    return;
+  }
+  const uint8_t *block = payload.data() + block_offset;
+  const std::size_t n_scan_points = std::min<std::size_t>(
+      ReadUint32(block),
+      (payload.size() - block_offset - kBeamsOffset) / kBeamSize);
+  beams.resize(n_scan_points);
+
+  float angle = derived_values.getStartAngle();
+  const float angle_delta = derived_values.getAngularBeamResolution();
+  const uint8_t *beam = block + kBeamsOffset;
+  for (std::size_t i = 0; i < n_scan_points; i++, beam += kBeamSize) {
+    beams.angles[i] = DegToRad(angle + angle_offset);
+    beams.distances[i] = ReadUint16(beam);
+    beams.reflectivities[i] = beam[2];
+    beams.status[i] = beam[3] & kStatusBits;
+    angle += angle_delta;
+  }
+}
+
+void ExtractScanBeams(
+    const sick::datastructure::MeasurementData &measurement_data,
+    float angle_offset, ScanBeams &beams) {
+  beams.resize(0);
+  if (measurement_data.isEmpty()) {
+    return;
+  }
+  // The library only hands out a copy of its scan points.
+  const std::vector<sick::datastructure::ScanPoint> scan_points =
+      measurement_data.getScanPointsVector();
+  const std::size_t n_scan_points = std::min<std::size_t>(
+      measurement_data.getNumberOfBeams(), scan_points.size());
+  beams.resize(n_scan_points);
+  for (std::size_t i = 0; i < n_scan_points; i++) {
+    const auto &scan_point = scan_points[i];
+    beams.angles[i] = DegToRad(scan_point.getAngle() + angle_offset);
+    beams.distances[i] = scan_point.getDistance();
+    beams.reflectivities[i] = scan_point.getReflectivity();
+    beams.status[i] =
+        (scan_point.getValidBit() ? kValidBit : 0) |
+        (scan_point.getInfiniteBit() ? kInfiniteBit : 0) |
+        (scan_point.getGlareBit() ? kGlareBit : 0) |
+        (scan_point.getReflectorBit() ? kReflectorBit : 0) |
+        (scan_point.getContaminationBit() ? kContaminationBit : 0) |
+        (scan_point.getContaminationWarningBit() ? kContaminationWarningBit
+                                                 : 0);
+  }
+}
+
+void DecodeMeasurementData(const std::vector<uint8_t> &payload,
+                           const sick::datastructure::Data &data,
+                           ::MeasurementDataProto::Builder builder,
+                           float angle_offset) {
+  // Same preconditions as sick::data_processing::ParseMeasurementData
+  const auto &header = *data.getDataHeaderPtr();
+  const auto &derived_values = *data.getDerivedValuesPtr();
+  if (header.isEmpty() || derived_values.isEmpty() ||
+      (header.getMeasurementDataBlockOffset() == 0 &&
+       header.getMeasurementDataBlockSize() == 0)) {
+    return;
+  }
+  const std::size_t block_offset = header.getMeasurementDataBlockOffset();
+  if (block_offset + kBeamsOffset > payload.size()) {
+    return;
+  }
+  const uint8_t *block = payload.data() + block_offset;
+  const uint32_t number_of_beams = ReadUint32(block);
+  // Never read beyond the payload, even if the number of beams is corrupted
+  const std::size_t n_scan_points = std::min<std::size_t>(
+      number_of_beams,
+      (payload.size() - block_offset - kBeamsOffset) / kBeamSize);
+
+  builder.setNumberOfBeams(number_of_beams);
+  auto scan_points = builder.initScanPoints(n_scan_points);
+
+  // The angles are accumulated in single precision like in the base library to
+  // get exactly the same values.
+  float angle = derived_values.getStartAngle();
+  const float angle_delta = derived_values.getAngularBeamResolution();
+  const uint8_t *beam = block + kBeamsOffset;
+  for (std::size_t i = 0; i < n_scan_points; i++, beam += kBeamSize) {
+    auto scan_point = scan_points[i];
+    auto status = scan_point.initStatus();
+    scan_point.setAngle(DegToRad(angle + angle_offset));
+    scan_point.setDistance(ReadUint16(beam));
+
+    const uint8_t flags = beam[3];
+    status.setContamination(flags & kContaminationBit);
+    status.setContaminationWarning(flags & kContaminationWarningBit);
+    status.setGlare(flags & kGlareBit);
+    status.setInfinite(flags & kInfiniteBit);
+    status.setReflectivity(beam[2]);
+    status.setReflector(flags & kReflectorBit);
+    status.setValid(flags & kValidBit);
+
+    angle += angle_delta;
+  }
+}
+
+void DecodeSafetyScan(const std::vector<uint8_t> &payload,
+                      const sick::datastructure::Data &data,
+                      ::SafetyScanProto::Builder builder, float angle_offset) {
+  ToProto(*data.getDataHeaderPtr(), builder.initHeader());
+  ToProto(*data.getDerivedValuesPtr(), builder.initDerivedValues(),
+          angle_offset);
+  ToProto(*data.getGeneralSystemStatePtr(), builder.initGeneralSystemState());
+  DecodeMeasurementData(payload, data, builder.initMeasurementData(),
+                        angle_offset);
+  ToProto(*data.getIntrusionDataPtr(), builder.initIntrusionData());
+  ToProto(*data.getApplicationDataPtr(), builder.initApplicationData());
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,163 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    scan_datagram.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "packages/sick/messages/safety_scan.hpp"
+
+#include <sick_safetyscanners_base/datastructure/Data.h>
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Reassembles the fragments of a measurement datagram. Every UDP packet starts with a datagram
+// header holding the total length, the identification and the fragment offset of the payload.
+class ScanDatagramAssembler
+{
+public:
+    static constexpr std::size_t kDatagramHeaderSize = 24;
+    // Upper bound of the total length of a datagram. Even 65535 beams with all data blocks stay
+    // well below it, so larger values stem from corrupt headers.
+    static constexpr std::size_t kMaxPayloadSize = 1 << 20;
+
+    // Adds a UDP packet. Fragments of an older datagram are discarded once a fragment of a new
+    // datagram arrives. Duplicated and overlapping fragments are ignored. Returns true if the
+    // packet completed a datagram, see payload().
+    bool addPacket(const uint8_t *packet, std::size_t size);
+    // The payload of the last completed datagram, starting with the data header.
+    const std::vector<uint8_t> &payload() const { return payload_; }
+
+private:
+    // A received part [begin, end) of the payload.
+    struct Fragment
+    {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    std::vector<uint8_t> payload_;
+    std::vector<Fragment> fragments_;
+    uint32_t identification_{0};
+    std::size_t received_{0};
+    bool active_{false};
+};
+
+// Receives measurement datagrams on a UDP socket of its own, bypassing the receive path of the
+// sick_safetyscanners_base library.
+class ScanDatagramReceiver
+{
+public:
+    ScanDatagramReceiver() = default;
+    ScanDatagramReceiver(const ScanDatagramReceiver &) = delete;
+    ScanDatagramReceiver &operator=(const ScanDatagramReceiver &) = delete;
+    ~ScanDatagramReceiver();
+
+    // Binds to the given UDP port on all interfaces. Port 0 selects a free port. Returns false on
+    // failure.
+    bool open(uint16_t port);
+    void close();
+    bool isOpen() const { return fd_ >= 0; }
+    // The port the socket is bound to.
+    uint16_t port() const { return port_; }
+    // Requests a kernel receive buffer of the given size [bytes]. Without CAP_NET_ADMIN the size
+    // is limited by net.core.rmem_max. Returns the effective size or -1 on failure.
+    int setReceiveBufferSize(int size);
+    // Waits until a datagram is complete. Returns false if the timeout elapsed before.
+    bool receive(std::chrono::milliseconds timeout);
+    // The payload of the last received datagram.
+    const std::vector<uint8_t> &payload() const { return assembler_.payload(); }
+
+private:
+    int fd_{-1};
+    uint16_t port_{0};
+    std::vector<uint8_t> packet_;
+    ScanDatagramAssembler assembler_;
+};
+
+// Appends a payload to a capture file. Every payload is stored with its size as little endian
+// uint32 in front.
+void WriteScanDatagramCapture(std::ostream &stream, const std::vector<uint8_t> &payload);
+// Reads the next payload of a capture file. Returns false at the end of the file.
+bool ReadScanDatagramCapture(std::istream &stream, std::vector<uint8_t> &payload);
+
+// Parses all data blocks of a datagram payload except the measurement data with the parsers of
+// the sick_safetyscanners_base library. These blocks are small; the beams are decoded directly.
+sick::datastructure::Data ParseScanDatagram(const std::vector<uint8_t> &payload);
+
+// Beams of a scan in columns. The columns keep their capacity, so filling them again does not
+// allocate once the largest scan has been seen.
+struct ScanBeams
+{
+    // [radians], including the angle offset
+    std::vector<float> angles;
+    // Distances as sent by the sensor, multiply with the multiplication factor to get millimeters.
+    std::vector<uint16_t> distances;
+    std::vector<uint8_t> reflectivities;
+    // Status bits as sent by the sensor: valid (bit 0), infinite (1), glare (2), reflector (3),
+    // contamination (4) and contamination warning (5).
+    std::vector<uint8_t> status;
+
+    std::size_t size() const { return distances.size(); }
+    void resize(std::size_t size);
+};
+
+// Decodes the beams of the measurement data block of the payload directly into columns without
+// creating scan points. The values are identical to those of the parsed MeasurementData.
+void DecodeScanBeams(const std::vector<uint8_t> &payload, const sick::datastructure::Data &data,
+                     float angle_offset, ScanBeams &beams);
+
+// Fills the columns from measurement data parsed by the sick_safetyscanners_base library.
+void ExtractScanBeams(const sick::datastructure::MeasurementData &measurement_data,
+                      float angle_offset, ScanBeams &beams);
+
+// Writes the measurement data block of the payload directly into the builder without creating
+// intermediate scan points. The result is identical to ToProto on the parsed MeasurementData.
+void DecodeMeasurementData(const std::vector<uint8_t> &payload,
+                           const sick::datastructure::Data &data,
+                           ::MeasurementDataProto::Builder builder, float angle_offset);
+
+// Equivalent of ToProto for a Data object which decodes the measurement data from the payload.
+void DecodeSafetyScan(const std::vector<uint8_t> &payload, const sick::datastructure::Data &data,
+                      ::SafetyScanProto::Builder builder, float angle_offset);
+
+} // namespace sick_safetyscanners
+} // namespace isaac
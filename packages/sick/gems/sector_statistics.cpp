@@ -0,0 +1,102 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    sector_statistics.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "sector_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+SectorStatistics::SectorStatistics(int sectors, float angle_min,
+                                   float angle_max)
+    : sectors_(std::max(sectors, 1)), angle_min_(angle_min),
+      angle_max_(angle_max) {
+  sector_width_ = std::max(angle_max - angle_min, 1e-6f) / sectors_.size();
+}
+
+void SectorStatistics::setHalfLife(double scans) {
+  decay_ = std::pow(0.5, 1.0 / std::max(scans, 1.0));
+}
+
+void SectorStatistics::beginScan() {
+  scans_++;
+  weight_ /= decay_;
+  if (weight_ > kMaxWeight) {
+    for (auto &sector : sectors_) {
+      sector.beams /= weight_;
+      sector.contamination /= weight_;
+      sector.contamination_warning /= weight_;
+      sector.glare /= weight_;
+    }
+    weight_ = 1.0;
+  }
+}
+
+void SectorStatistics::addBeam(float angle, bool contamination,
+                               bool contamination_warning, bool glare) {
+  if (!(angle >= angle_min_ && angle <= angle_max_)) {
+    return;
+  }
+  // A beam at angle_max belongs to the last sector
+  const std::size_t index =
+      std::min(static_cast<std::size_t>((angle - angle_min_) / sector_width_),
+               sectors_.size() - 1);
+  Sector &sector = sectors_[index];
+  sector.beams += weight_;
+  if (contamination) {
+    sector.contamination += weight_;
+  }
+  if (contamination_warning) {
+    sector.contamination_warning += weight_;
+  }
+  if (glare) {
+    sector.glare += weight_;
+  }
+}
+
+void SectorStatistics::reset() {
+  std::fill(sectors_.begin(), sectors_.end(), Sector{});
+  weight_ = 1.0;
+  scans_ = 0;
+}
+
+SectorStatistics::Sector SectorStatistics::sector(int i) const {
+  const Sector &sector = sectors_[i];
+  return Sector{sector.beams / weight_, sector.contamination / weight_,
+                sector.contamination_warning / weight_, sector.glare / weight_};
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,97 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    sector_statistics.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Exponentially decayed per-sector counters of beam status flags. The field of view is divided
+// into equally sized angular sectors; each beam is counted in the sector containing its angle.
+//
+// Decay is applied lazily: instead of scaling all counters with every scan, new samples are
+// weighted with a growing factor and the counters are divided by it when read. Adding a beam and
+// starting a scan are therefore O(1) and memory is fixed after construction.
+class SectorStatistics
+{
+public:
+    // Decayed counts of a single sector.
+    struct Sector
+    {
+        double beams{0.0};
+        double contamination{0.0};
+        double contamination_warning{0.0};
+        double glare{0.0};
+    };
+
+    // Divides [angle_min, angle_max] [radians] into the given number of sectors.
+    SectorStatistics(int sectors, float angle_min, float angle_max);
+
+    // Sets the number of scans after which a sample has half of its initial weight.
+    void setHalfLife(double scans);
+    // Starts a new scan. All previous samples decay by one step.
+    void beginScan();
+    // Counts a single beam. Beams outside of the field of view are ignored.
+    void addBeam(float angle, bool contamination, bool contamination_warning, bool glare);
+    // Forgets all samples.
+    void reset();
+
+    // Decayed counts of the i-th sector.
+    Sector sector(int i) const;
+    int size() const { return static_cast<int>(sectors_.size()); }
+    float angleMin() const { return angle_min_; }
+    float sectorWidth() const { return sector_width_; }
+    // Number of scans since construction or the last reset.
+    uint64_t scans() const { return scans_; }
+
+private:
+    // Weight above which all counters are rescaled to avoid overflow.
+    static constexpr double kMaxWeight = 1e100;
+
+    std::vector<Sector> sectors_;
+    float angle_min_;
+    float angle_max_;
+    float sector_width_;
+    double decay_{0.99};
+    // Weight of samples of the current scan
+    double weight_{1.0};
+    uint64_t scans_{0};
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,307 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    shared_scan_ring.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "shared_scan_ring.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+constexpr std::size_t kAlignment = 64;
+
+inline std::size_t AlignUp(std::size_t value) {
+  return (value + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+// Offsets of the parts of a slot, relative to its start.
+struct SlotLayout {
+  explicit SlotLayout(uint32_t max_beams) {
+    record = AlignUp(sizeof(std::atomic<uint64_t>));
+    angles = AlignUp(record + sizeof(SharedScanRecord));
+    distances = AlignUp(angles + max_beams * sizeof(float));
+    reflectivities = AlignUp(distances + max_beams * sizeof(uint16_t));
+    status = AlignUp(reflectivities + max_beams * sizeof(uint8_t));
+    size = AlignUp(status + max_beams * sizeof(uint8_t));
+  }
+
+  std::size_t record;
+  std::size_t angles;
+  std::size_t distances;
+  std::size_t reflectivities;
+  std::size_t status;
+  std::size_t size;
+};
+
+inline std::size_t HeaderSize() { return AlignUp(sizeof(SharedScanRingHeader)); }
+
+inline std::atomic<uint64_t> &SlotLock(uint8_t *slot) {
+  return *reinterpret_cast<std::atomic<uint64_t> *>(slot);
+}
+
+inline const std::atomic<uint64_t> &SlotLock(const uint8_t *slot) {
+  return *reinterpret_cast<const std::atomic<uint64_t> *>(slot);
+}
+
+// Lock value of a slot while the scan with the given sequence is written and once it is complete.
+inline uint64_t WritingLock(uint64_t sequence) { return 2 * sequence + 1; }
+inline uint64_t CompleteLock(uint64_t sequence) { return 2 * sequence + 2; }
+
+int64_t RealtimeNanoseconds() {
+  timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+} // namespace
+
+SharedScanWriter::~SharedScanWriter() { close(); }
+
+bool SharedScanWriter::open(const std::string &path, uint32_t slot_count,
+                            uint32_t max_beams) {
+  close();
+  if (slot_count == 0 || max_beams == 0) {
+    error_ = "slot_count and max_beams have to be positive";
+    return false;
+  }
+
+  const SlotLayout layout(max_beams);
+  const std::size_t size = HeaderSize() + slot_count * layout.size;
+
+  // Readers may still map the previous ring. Truncating that file would make
+  // their accesses fault, so the ring is set up in a new file which replaces it.
+  std::string temporary_path = path + ".XXXXXX";
+  const int fd = ::mkstemp(&temporary_path[0]);
+  if (fd < 0) {
+    error_ = std::string("mkstemp failed: ") + std::strerror(errno);
+    return false;
+  }
+  if (::fchmod(fd, 0644) != 0 ||
+      ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    error_ = std::string("ftruncate failed: ") + std::strerror(errno);
+    ::close(fd);
+    ::unlink(temporary_path.c_str());
+    return false;
+  }
+  void *memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (memory == MAP_FAILED) {
+    error_ = std::string("mmap failed: ") + std::strerror(errno);
+    ::unlink(temporary_path.c_str());
+    return false;
+  }
+
+  // The file is zero-filled, so all slot locks start out as "never written"
+  auto *header = new (memory) SharedScanRingHeader;
+  header->slot_count = slot_count;
+  header->max_beams = max_beams;
+  header->slot_size = layout.size;
+  header->write_count.store(0, std::memory_order_relaxed);
+  header->version = SharedScanRingHeader::kVersion;
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = SharedScanRingHeader::kMagic;
+
+  // Readers opening the path from now on see the complete new ring
+  if (::rename(temporary_path.c_str(), path.c_str()) != 0) {
+    error_ = std::string("rename failed: ") + std::strerror(errno);
+    ::munmap(memory, size);
+    ::unlink(temporary_path.c_str());
+    return false;
+  }
+
+  mapped_size_ = size;
+  header_ = header;
+  slots_ = static_cast<uint8_t *>(memory) + HeaderSize();
+  error_.clear();
+  return true;
+}
+
+void SharedScanWriter::close() {
+  if (header_ != nullptr) {
+    ::munmap(header_, mapped_size_);
+  }
+  header_ = nullptr;
+  slots_ = nullptr;
+  mapped_size_ = 0;
+}
+
+SharedScanRecord *SharedScanWriter::beginWrite(float *&angles,
+                                               uint16_t *&distances,
+                                               uint8_t *&reflectivities,
+                                               uint8_t *&status) {
+  const uint64_t sequence = header_->write_count.load(std::memory_order_relaxed);
+  current_slot_ = static_cast<uint32_t>(sequence % header_->slot_count);
+  uint8_t *slot = slots_ + current_slot_ * header_->slot_size;
+
+  SlotLock(slot).store(WritingLock(sequence), std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  const SlotLayout layout(header_->max_beams);
+  angles = reinterpret_cast<float *>(slot + layout.angles);
+  distances = reinterpret_cast<uint16_t *>(slot + layout.distances);
+  reflectivities = slot + layout.reflectivities;
+  status = slot + layout.status;
+
+  auto *record = reinterpret_cast<SharedScanRecord *>(slot + layout.record);
+  std::memset(record, 0, sizeof(SharedScanRecord));
+  record->sequence = sequence;
+  return record;
+}
+
+void SharedScanWriter::commit() {
+  const uint64_t sequence = header_->write_count.load(std::memory_order_relaxed);
+  uint8_t *slot = slots_ + current_slot_ * header_->slot_size;
+  const SlotLayout layout(header_->max_beams);
+  reinterpret_cast<SharedScanRecord *>(slot + layout.record)->write_time =
+      RealtimeNanoseconds();
+
+  SlotLock(slot).store(CompleteLock(sequence), std::memory_order_release);
+  header_->write_count.store(sequence + 1, std::memory_order_release);
+}
+
+SharedScanReader::~SharedScanReader() { close(); }
+
+bool SharedScanReader::open(const std::string &path) {
+  close();
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    error_ = std::string("open failed: ") + std::strerror(errno);
+    return false;
+  }
+  struct stat file_stat;
+  if (::fstat(fd, &file_stat) != 0 ||
+      static_cast<std::size_t>(file_stat.st_size) < HeaderSize()) {
+    error_ = "file is too small to contain a scan ring";
+    ::close(fd);
+    return false;
+  }
+  const std::size_t size = static_cast<std::size_t>(file_stat.st_size);
+  void *memory = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (memory == MAP_FAILED) {
+    error_ = std::string("mmap failed: ") + std::strerror(errno);
+    return false;
+  }
+
+  const auto *header = static_cast<const SharedScanRingHeader *>(memory);
+  if (header->magic != SharedScanRingHeader::kMagic ||
+      header->version != SharedScanRingHeader::kVersion ||
+      header->slot_size != SlotLayout(header->max_beams).size ||
+      HeaderSize() + header->slot_count * header->slot_size > size) {
+    error_ = "file does not contain a compatible scan ring";
+    ::munmap(memory, size);
+    return false;
+  }
+
+  header_ = header;
+  slots_ = static_cast<const uint8_t *>(memory) + HeaderSize();
+  mapped_size_ = size;
+  path_ = path;
+  device_ = file_stat.st_dev;
+  inode_ = file_stat.st_ino;
+  error_.clear();
+  return true;
+}
+
+void SharedScanReader::close() {
+  if (header_ != nullptr) {
+    ::munmap(const_cast<SharedScanRingHeader *>(header_), mapped_size_);
+  }
+  header_ = nullptr;
+  slots_ = nullptr;
+  mapped_size_ = 0;
+}
+
+uint64_t SharedScanReader::writeCount() const {
+  return header_->write_count.load(std::memory_order_acquire);
+}
+
+SharedScanReader::Status
+SharedScanReader::beginRead(uint64_t sequence, SharedScanView &view) const {
+  const uint64_t write_count = writeCount();
+  if (sequence >= write_count) {
+    return Status::kNotAvailable;
+  }
+  if (write_count - sequence > header_->slot_count) {
+    return Status::kOverrun;
+  }
+
+  const uint32_t slot_index =
+      static_cast<uint32_t>(sequence % header_->slot_count);
+  const uint8_t *slot = slots_ + slot_index * header_->slot_size;
+  const uint64_t lock = SlotLock(slot).load(std::memory_order_acquire);
+  // The slot can only differ from the expected scan if a newer one has been or
+  // is being written into it
+  if (lock != CompleteLock(sequence)) {
+    return Status::kOverrun;
+  }
+
+  const SlotLayout layout(header_->max_beams);
+  view.record = reinterpret_cast<const SharedScanRecord *>(slot + layout.record);
+  view.angles = reinterpret_cast<const float *>(slot + layout.angles);
+  view.distances = reinterpret_cast<const uint16_t *>(slot + layout.distances);
+  view.reflectivities = slot + layout.reflectivities;
+  view.status = slot + layout.status;
+  view.lock = lock;
+  view.slot = slot_index;
+  return Status::kOk;
+}
+
+bool SharedScanReader::endRead(const SharedScanView &view) const {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint8_t *slot = slots_ + view.slot * header_->slot_size;
+  return SlotLock(slot).load(std::memory_order_relaxed) == view.lock;
+}
+
+bool SharedScanReader::isReplaced() const {
+  struct stat file_stat;
+  if (::stat(path_.c_str(), &file_stat) != 0) {
+    return true;
+  }
+  return static_cast<uint64_t>(file_stat.st_dev) != device_ ||
+         static_cast<uint64_t>(file_stat.st_ino) != inode_;
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,205 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+*  Copyright (C) 2020, SICK AG, Waldkirch
+*  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+*
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!
+ * \file    shared_scan_ring.hpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace isaac
+{
+namespace sick_safetyscanners
+{
+
+// Status bits of a beam in SharedScanRecord::status, identical to the measurement datagram.
+enum SharedScanBeamStatus : uint8_t
+{
+    kBeamValid = 1 << 0,
+    kBeamInfinite = 1 << 1,
+    kBeamGlare = 1 << 2,
+    kBeamReflector = 1 << 3,
+    kBeamContamination = 1 << 4,
+    kBeamContaminationWarning = 1 << 5,
+};
+
+// Metadata of a scan stored in a slot of the ring. The beam data follows it in columns of
+// max_beams entries each, see SharedScanView.
+struct SharedScanRecord
+{
+    // Index of this scan in the ring, starting at 0.
+    uint64_t sequence;
+    // Time the scan was written [nanoseconds since epoch, CLOCK_REALTIME].
+    int64_t write_time;
+    uint32_t serial_number;
+    uint32_t scan_number;
+    uint32_t sequence_number;
+    uint32_t channel;
+    // Angle of the first beam and angle between two beams [radians].
+    float start_angle;
+    float angular_resolution;
+    // Scan time [ms] and factor to convert distances to millimeter.
+    uint16_t scan_time;
+    uint16_t multiplication_factor;
+    uint32_t number_of_beams;
+};
+
+// Pointers to a scan inside the shared memory. Only valid until SharedScanReader::endRead returns.
+struct SharedScanView
+{
+    const SharedScanRecord *record{nullptr};
+    // Beam columns with record->number_of_beams valid entries.
+    const float *angles{nullptr};
+    const uint16_t *distances{nullptr};
+    const uint8_t *reflectivities{nullptr};
+    const uint8_t *status{nullptr};
+    // Lock value of the slot when the read began.
+    uint64_t lock{0};
+    uint32_t slot{0};
+};
+
+// Layout of the shared memory: a header followed by slot_count slots of slot_size bytes.
+// Every slot starts with a sequence lock which is odd while the writer modifies the slot.
+struct SharedScanRingHeader
+{
+    static constexpr uint32_t kMagic = 0x534b5352; // "SKSR"
+    static constexpr uint32_t kVersion = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t max_beams;
+    uint64_t slot_size;
+    // Number of scans written so far. The latest scan has the sequence write_count - 1.
+    std::atomic<uint64_t> write_count;
+};
+
+// Writes scans into a ring of slots in a memory mapped file (e.g. in /dev/shm). There must only be
+// a single writer per file. Readers are never blocked; they detect overwritten and torn slots.
+//
+// Every open() creates a new file and renames it over the path. Readers which still map the previous
+// file keep a valid mapping and detect the replacement with SharedScanReader::isReplaced().
+class SharedScanWriter
+{
+public:
+    SharedScanWriter() = default;
+    SharedScanWriter(const SharedScanWriter &) = delete;
+    SharedScanWriter &operator=(const SharedScanWriter &) = delete;
+    ~SharedScanWriter();
+
+    // Creates a new ring at the given path, replacing an existing file. Returns false on failure,
+    // see error().
+    bool open(const std::string &path, uint32_t slot_count, uint32_t max_beams);
+    void close();
+    bool isOpen() const { return header_ != nullptr; }
+    const std::string &error() const { return error_; }
+    uint32_t maxBeams() const { return isOpen() ? header_->max_beams : 0; }
+
+    // Locks the next slot and returns pointers to its columns. The record sequence is set already.
+    // Must be followed by commit().
+    SharedScanRecord *beginWrite(float *&angles, uint16_t *&distances, uint8_t *&reflectivities,
+                                 uint8_t *&status);
+    // Unlocks the slot and makes the scan visible to readers.
+    void commit();
+
+private:
+    SharedScanRingHeader *header_{nullptr};
+    uint8_t *slots_{nullptr};
+    std::size_t mapped_size_{0};
+    uint32_t current_slot_{0};
+    std::string error_;
+};
+
+// Reads scans from a ring created by SharedScanWriter without copying them.
+//
+//   SharedScanView view;
+//   if (reader.beginRead(reader.latestSequence(), view) == SharedScanReader::Status::kOk) {
+//     ... process view ...
+//     if (!reader.endRead(view)) { ... discard the results, the slot was overwritten ... }
+//   }
+//
+// If no new scans arrive for a while, isReplaced() tells whether the writer has been restarted
+// and the reader has to open() the path again.
+class SharedScanReader
+{
+public:
+    // Result of beginRead.
+    enum class Status
+    {
+        kOk,
+        // No scan with this sequence has been written yet.
+        kNotAvailable,
+        // The scan has been or is being overwritten by a newer one, i.e. the reader fell behind by
+        // more than the ring size. Continue at latestSequence().
+        kOverrun,
+    };
+
+    SharedScanReader() = default;
+    SharedScanReader(const SharedScanReader &) = delete;
+    SharedScanReader &operator=(const SharedScanReader &) = delete;
+    ~SharedScanReader();
+
+    // Maps an existing ring read-only. Returns false on failure, see error().
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const { return header_ != nullptr; }
+    const std::string &error() const { return error_; }
+
+    // Number of scans written so far.
+    uint64_t writeCount() const;
+    // Sequence of the latest complete scan. Only meaningful if writeCount() > 0.
+    uint64_t latestSequence() const { return writeCount() - 1; }
+
+    // Starts a zero-copy read of the scan with the given sequence.
+    Status beginRead(uint64_t sequence, SharedScanView &view) const;
+    // Returns false if the slot was modified since beginRead, i.e. the view may be torn.
+    bool endRead(const SharedScanView &view) const;
+
+    // Returns true if the path no longer refers to the mapped ring, e.g. because the writer has
+    // been restarted. The mapping stays valid, but no further scans will be written into it.
+    bool isReplaced() const;
+
+private:
+    const SharedScanRingHeader *header_{nullptr};
+    const uint8_t *slots_{nullptr};
+    std::size_t mapped_size_{0};
+    std::string path_;
+    // Identity of the mapped file.
+    uint64_t device_{0};
+    uint64_t inode_{0};
+    std::string error_;
+};
+
+} // namespace sick_safetyscanners
+} // namespace isaac
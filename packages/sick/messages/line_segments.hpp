@@ -24,47 +24,16 @@
 
 //----------------------------------------------------------------------
 /*!
- * \file    Consumer.hpp
+ * \file    line_segments.hpp
  *
- * \author  Martin Schulze <schulze@fzi.de>
- * \date    2020-04-15
+ * \author  agent <agent@local>
+ * \date    2026-10-19
  */
 //----------------------------------------------------------------------
 
 #pragma once
 
-#include <memory>
-#include <string>
-#include <vector>
+#include "packages/sick/messages/line_segments.capnp.h"
+#include "messages/proto_registry.hpp"
 
-#include "engine/alice/alice.hpp"
-#include "engine/alice/alice_codelet.hpp"
-#include "messages/messages.hpp"
-#include "engine/core/byte.hpp"
-
-#include "messages/messages.hpp"
-
-#include "packages/sick/messages/safety_scan.hpp"
-#include "packages/sick/messages/commands.hpp"
-
-namespace isaac
-{
-
-namespace sick_safetyscanners
-{
-
-class Consumer : public isaac::alice::Codelet
-{
-public:
-    void start() override;
-    void tick() override;
-    void stop() override;
-
-    ISAAC_PROTO_RX(SafetyScanProto, safety_scan);
-    ISAAC_PROTO_TX(FindMeCommandProto, find_me_cmd);
-};
-
-} // namespace sick_components
-} // namespace isaac
-
-ISAAC_ALICE_REGISTER_CODELET(isaac::sick_safetyscanners::Consumer);
+ISAAC_ALICE_REGISTER_PROTO(LineSegmentsProto);
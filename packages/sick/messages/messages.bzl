@@ -17,6 +17,11 @@ load("@com_nvidia_isaac//engine/build:cc_capnp_library.bzl", "cc_capnp_library")
 _protos = [
     ["safety_scan",        []],
     ["commands", []],
+    ["occupancy_grid", []],
+    ["optics_health", []],
+    ["safety_scan_batch", []],
+    ["line_segments", []],
+    ["synchronized_scans", ["safety_scan"]],
 ]
 
 def _proto_library_name(x):
@@ -36,6 +36,7 @@
 #include "packages/sick/messages/safety_scan.capnp.h"
 #include "messages/proto_registry.hpp"
 #include "messages/math.hpp"
+#include <algorithm>
 #include <sick_safetyscanners_base/datastructure/ScanPoint.h>
 #include <sick_safetyscanners_base/datastructure/Data.h>
 #include <sick_safetyscanners_base/datastructure/FieldData.h>
@@ -55,8 +56,7 @@ namespace sick_safetyscanners
 
 inline void ToProto(const sick::datastructure::ScanPoint &scan_point, ::ScanPointProto::Builder builder, float angle_offset)
 {
-    builder.initStatus();
-    auto status = builder.getStatus();
+    auto status = builder.initStatus();
 
     builder.setAngle(DegToRad(scan_point.getAngle() + angle_offset));
     builder.setDistance(scan_point.getDistance());
@@ -100,27 +100,31 @@ inline void ToProto(const sick::datastructure::ApplicationInputs &application_in
     // UnsafeInputs
     builder.initUnsafeInputs();
     auto unsafe_inputs = builder.getUnsafeInputs();
-    const std::size_t n_unsafe_inputs = application_inputs.getUnsafeInputsFlagsVector().size();
+    const auto unsafe_input_sources = application_inputs.getUnsafeInputsInputSourcesVector();
+    const auto unsafe_input_flags = application_inputs.getUnsafeInputsFlagsVector();
+    const std::size_t n_unsafe_inputs = unsafe_input_flags.size();
 
-    unsafe_inputs.initInputSources(n_unsafe_inputs);
-    unsafe_inputs.initFlags(n_unsafe_inputs);
+    auto input_sources_builder = unsafe_inputs.initInputSources(n_unsafe_inputs);
+    auto flags_builder = unsafe_inputs.initFlags(n_unsafe_inputs);
     for (std::size_t i = 0; i < n_unsafe_inputs; i++)
     {
-        unsafe_inputs.getInputSources().set(i, application_inputs.getUnsafeInputsInputSourcesVector()[i]);
-        unsafe_inputs.getFlags().set(i, application_inputs.getUnsafeInputsFlagsVector()[i]);
+        input_sources_builder.set(i, unsafe_input_sources[i]);
+        flags_builder.set(i, unsafe_input_flags[i]);
     }
 
     // MonitoringCaseNumberInputs
     builder.initMonitoringCaseNumberInputs();
     auto monitoring_cases = builder.getMonitoringCaseNumberInputs();
-    const std::size_t n_monitoring_cases = application_inputs.getMonitoringCasevector().size();
+    const auto monitoring_case_numbers = application_inputs.getMonitoringCasevector();
+    const auto monitoring_case_flags = application_inputs.getMonitoringCaseFlagsVector();
+    const std::size_t n_monitoring_cases = monitoring_case_numbers.size();
 
-    monitoring_cases.initMonitoringCaseNumber(n_monitoring_cases);
-    monitoring_cases.initMonitoringCaseNumberFlags(n_monitoring_cases);
+    auto numbers_builder = monitoring_cases.initMonitoringCaseNumber(n_monitoring_cases);
+    auto number_flags_builder = monitoring_cases.initMonitoringCaseNumberFlags(n_monitoring_cases);
     for (std::size_t i = 0; i < n_monitoring_cases; i++)
     {
-        monitoring_cases.getMonitoringCaseNumber().set(i, application_inputs.getMonitoringCasevector()[i]);
-        monitoring_cases.getMonitoringCaseNumberFlags().set(i, application_inputs.getMonitoringCaseFlagsVector()[i]);
+        numbers_builder.set(i, monitoring_case_numbers[i]);
+        number_flags_builder.set(i, monitoring_case_flags[i]);
     }
 
     // LinearVelocityInputs
@@ -141,27 +145,32 @@ inline void ToProto(const sick::datastructure::ApplicationOutputs &application_o
     // EvaluationPathsOutputs
     builder.initEvaluationPathsOutputs();
     auto evaluation_paths = builder.getEvaluationPathsOutputs();
-    const std::size_t n_eval_out = application_outputs.getEvalOutVector().size();
-    evaluation_paths.initEvalOut(n_eval_out);
-    evaluation_paths.initIsSafe(n_eval_out);
-    evaluation_paths.initIsValid(n_eval_out);
+    const auto eval_out = application_outputs.getEvalOutVector();
+    const auto eval_out_is_safe = application_outputs.getEvalOutIsSafeVector();
+    const auto eval_out_is_valid = application_outputs.getEvalOutIsValidVector();
+    const std::size_t n_eval_out = eval_out.size();
+    auto eval_out_builder = evaluation_paths.initEvalOut(n_eval_out);
+    auto is_safe_builder = evaluation_paths.initIsSafe(n_eval_out);
+    auto is_valid_builder = evaluation_paths.initIsValid(n_eval_out);
     for (std::size_t i = 0; i < n_eval_out; i++)
     {
-        evaluation_paths.getEvalOut().set(i, application_outputs.getEvalOutVector()[i]);
-        evaluation_paths.getIsSafe().set(i, application_outputs.getEvalOutIsSafeVector()[i]);
-        evaluation_paths.getIsValid().set(i, application_outputs.getEvalOutIsValidVector()[i]);
+        eval_out_builder.set(i, eval_out[i]);
+        is_safe_builder.set(i, eval_out_is_safe[i]);
+        is_valid_builder.set(i, eval_out_is_valid[i]);
     }
 
     // MonitoringCaseNumberOutputs
     builder.initMonitoringCaseNumberOutputs();
     auto monitoring_cases = builder.getMonitoringCaseNumberOutputs();
-    const std::size_t n_monitoring_cases = application_outputs.getMonitoringCaseVector().size();
-    monitoring_cases.initMonitoringCaseNumber(n_monitoring_cases);
-    monitoring_cases.initFlags(n_monitoring_cases);
+    const auto monitoring_case_numbers = application_outputs.getMonitoringCaseVector();
+    const auto monitoring_case_flags = application_outputs.getMonitoringCaseFlagsVector();
+    const std::size_t n_monitoring_cases = monitoring_case_numbers.size();
+    auto numbers_builder = monitoring_cases.initMonitoringCaseNumber(n_monitoring_cases);
+    auto flags_builder = monitoring_cases.initFlags(n_monitoring_cases);
     for (std::size_t i = 0; i < n_monitoring_cases; i++)
     {
-        monitoring_cases.getMonitoringCaseNumber().set(i, application_outputs.getMonitoringCaseVector()[i]);
-        monitoring_cases.getFlags().set(i, application_outputs.getMonitoringCaseFlagsVector()[i]);
+        numbers_builder.set(i, monitoring_case_numbers[i]);
+        flags_builder.set(i, monitoring_case_flags[i]);
     }
 
     builder.setSleepModeOutput(application_outputs.getSleepModeOutput());
@@ -192,13 +201,15 @@ inline void ToProto(const sick::datastructure::ApplicationOutputs &application_o
     // ResultingVelocity
     builder.initResultingVelocity();
     auto resulting_velocity = builder.getResultingVelocity();
-    const std::size_t n_resulting_velocities = application_outputs.getResultingVelocityVector().size();
-    resulting_velocity.initResultingVelocity(n_resulting_velocities);
-    resulting_velocity.initFlags(n_resulting_velocities);
+    const auto resulting_velocities = application_outputs.getResultingVelocityVector();
+    const auto resulting_velocities_valid = application_outputs.getResultingVelocityIsValidVector();
+    const std::size_t n_resulting_velocities = resulting_velocities.size();
+    auto velocities_builder = resulting_velocity.initResultingVelocity(n_resulting_velocities);
+    auto velocity_flags_builder = resulting_velocity.initFlags(n_resulting_velocities);
     for (std::size_t i = 0; i < n_resulting_velocities; i++)
     {
-        resulting_velocity.getResultingVelocity().set(i, application_outputs.getResultingVelocityVector()[i]);
-        resulting_velocity.getFlags().set(i, application_outputs.getResultingVelocityIsValidVector()[i]);
+        velocities_builder.set(i, resulting_velocities[i]);
+        velocity_flags_builder.set(i, resulting_velocities_valid[i]);
     }
 }
 
@@ -216,11 +227,12 @@ inline void ToProto(const sick::datastructure::FieldData &field_data, ::FieldDat
 {
     builder.setAngularResolution(field_data.getAngularBeamResolution());
     builder.setProtectiveField(field_data.getIsProtectiveField());
-    const std::size_t n_ranges = field_data.getBeamDistances().size();
-    builder.initRanges(n_ranges);
+    const auto beam_distances = field_data.getBeamDistances();
+    const std::size_t n_ranges = beam_distances.size();
+    auto ranges = builder.initRanges(n_ranges);
     for (std::size_t i = 0; i < n_ranges; i++)
     {
-        builder.getRanges().set(i, static_cast<float>(field_data.getBeamDistances()[i]) * 1e-3);
+        ranges.set(i, static_cast<float>(beam_distances[i]) * 1e-3);
     }
 }
 
@@ -249,25 +261,25 @@ inline void ToProto(const sick::datastructure::GeneralSystemState &system_state,
         builder.setReferenceContourStatus(system_state.getReferenceContourStatus());
         builder.setManipulationStatus(system_state.getManipulationStatus());
 
-        const std::size_t n_safe_cut_off_paths = system_state.getSafeCutOffPathVector().size();
-        builder.initSafeCutOffPath(n_safe_cut_off_paths);
-        for (std::size_t i = 0; i < n_safe_cut_off_paths; i++)
+        const auto safe_cut_off_paths = system_state.getSafeCutOffPathVector();
+        auto safe_cut_off_path_builder = builder.initSafeCutOffPath(safe_cut_off_paths.size());
+        for (std::size_t i = 0; i < safe_cut_off_paths.size(); i++)
         {
-            builder.getSafeCutOffPath().set(i, system_state.getSafeCutOffPathVector()[i]);
+            safe_cut_off_path_builder.set(i, safe_cut_off_paths[i]);
         }
 
-        const std::size_t n_non_safe_cut_off_paths = system_state.getNonSafeCutOffPathVector().size();
-        builder.initNonSafeCutOffPath(n_non_safe_cut_off_paths);
-        for (std::size_t i = 0; i < n_non_safe_cut_off_paths; i++)
+        const auto non_safe_cut_off_paths = system_state.getNonSafeCutOffPathVector();
+        auto non_safe_cut_off_path_builder = builder.initNonSafeCutOffPath(non_safe_cut_off_paths.size());
+        for (std::size_t i = 0; i < non_safe_cut_off_paths.size(); i++)
         {
-            builder.getNonSafeCutOffPath().set(i, system_state.getNonSafeCutOffPathVector()[i]);
+            non_safe_cut_off_path_builder.set(i, non_safe_cut_off_paths[i]);
         }
 
-        const std::size_t n_reset_required_cut_off_paths = system_state.getResetRequiredCutOffPathVector().size();
-        builder.initResetRequiredCutOffPath(n_reset_required_cut_off_paths);
-        for (std::size_t i = 0; i < n_reset_required_cut_off_paths; i++)
+        const auto reset_required_cut_off_paths = system_state.getResetRequiredCutOffPathVector();
+        auto reset_required_cut_off_path_builder = builder.initResetRequiredCutOffPath(reset_required_cut_off_paths.size());
+        for (std::size_t i = 0; i < reset_required_cut_off_paths.size(); i++)
         {
-            builder.getResetRequiredCutOffPath().set(i, system_state.getResetRequiredCutOffPathVector()[i]);
+            reset_required_cut_off_path_builder.set(i, reset_required_cut_off_paths[i]);
         }
 
         builder.setCurrentMonitoringcaseNoTable1(system_state.getCurrentMonitoringCaseNoTable1());
@@ -283,24 +295,27 @@ inline void ToProto(const sick::datastructure::MeasurementData &measurements, ::
 {
     if (!measurements.isEmpty())
     {
-        std::size_t n_scan_points = measurements.getNumberOfBeams();
-        builder.setNumberOfBeams(n_scan_points);
-        builder.initScanPoints(n_scan_points);
+        // The scan points are returned by value, so they are fetched only once per scan.
+        const auto scan_points = measurements.getScanPointsVector();
+        const std::size_t n_scan_points = std::min<std::size_t>(measurements.getNumberOfBeams(), scan_points.size());
+        builder.setNumberOfBeams(measurements.getNumberOfBeams());
+        auto scan_points_builder = builder.initScanPoints(n_scan_points);
         for (std::size_t i = 0; i < n_scan_points; i++)
         {
-            ToProto(measurements.getScanPointsVector()[i], builder.getScanPoints()[i], angle_offset);
+            ToProto(scan_points[i], scan_points_builder[i], angle_offset);
         }
     }
 }
 
 inline void ToProto(const sick::datastructure::IntrusionDatum &intrusion, ::IntrusionDatumProto::Builder builder)
 {
-    const std::size_t n_flags = intrusion.getFlagsVector().size();
+    const auto flags = intrusion.getFlagsVector();
+    const std::size_t n_flags = flags.size();
     builder.setSize(n_flags);
-    builder.initFlags(n_flags);
+    auto flags_builder = builder.initFlags(n_flags);
     for (std::size_t i = 0; i < n_flags; i++)
     {
-        builder.getFlags().set(i, intrusion.getFlagsVector()[i]);
+        flags_builder.set(i, flags[i]);
     }
 }
 
@@ -308,11 +323,12 @@ inline void ToProto(const sick::datastructure::IntrusionData &intrusion, ::Intru
 {
     if (!intrusion.isEmpty())
     {
-        const std::size_t n_intrusions = intrusion.getIntrusionDataVector().size();
-        builder.initData(n_intrusions);
+        const auto intrusions = intrusion.getIntrusionDataVector();
+        const std::size_t n_intrusions = intrusions.size();
+        auto data_builder = builder.initData(n_intrusions);
         for (std::size_t i = 0; i < n_intrusions; i++)
         {
-            ToProto(intrusion.getIntrusionDataVector()[i], builder.getData()[i]);
+            ToProto(intrusions[i], data_builder[i]);
         }
     }
 }
@@ -0,0 +1,157 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    AdaptiveRate.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+#include "packages/sick/gems/adaptive_rate.hpp"
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+constexpr double kBudget = 0.01;
+
+// Feeds the same observation the given number of times and updates the
+// decimator after each one, as the codelet does for every scan.
+void Observe(LoadMonitor &monitor, AdaptiveDecimator &decimator,
+             double publish_latency, double receive_wait, int scans) {
+  for (int i = 0; i < scans; i++) {
+    monitor.addSample(publish_latency, receive_wait);
+    decimator.update(monitor);
+  }
+}
+
+} // namespace
+
+TEST(AdaptiveRate, MonitorDetectsLatencyAndBacklog) {
+  LoadMonitor monitor;
+  monitor.configure(kBudget, 0.5, 0.001);
+  EXPECT_FALSE(monitor.overloaded());
+  EXPECT_FALSE(monitor.relaxed());
+
+  monitor.addSample(0.002, 0.02);
+  EXPECT_TRUE(monitor.relaxed());
+  monitor.addSample(0.05, 0.02);
+  EXPECT_TRUE(monitor.overloaded());
+
+  // Scans which are already queued count as overload despite a low latency
+  monitor.reset();
+  for (int i = 0; i < 2; i++) {
+    monitor.addSample(0.002, 0.0);
+    EXPECT_FALSE(monitor.overloaded());
+  }
+  monitor.addSample(0.002, 0.0);
+  EXPECT_TRUE(monitor.overloaded());
+  EXPECT_EQ(3, monitor.backlog());
+  monitor.addSample(0.002, 0.02);
+  EXPECT_EQ(0, monitor.backlog());
+  EXPECT_FALSE(monitor.overloaded());
+}
+
+TEST(AdaptiveRate, DecimationRampsUpUnderSustainedOverload) {
+  LoadMonitor monitor;
+  monitor.configure(kBudget, 0.5, 0.001);
+  AdaptiveDecimator decimator;
+  decimator.configure(8);
+
+  Observe(monitor, decimator, 0.05, 0.02, 1);
+  EXPECT_EQ(2, decimator.decimation());
+  // The decimation is held while the latency settles
+  Observe(monitor, decimator, 0.05, 0.02, 10);
+  EXPECT_EQ(2, decimator.decimation());
+  Observe(monitor, decimator, 0.05, 0.02, 1);
+  EXPECT_EQ(4, decimator.decimation());
+  Observe(monitor, decimator, 0.05, 0.02, 11);
+  EXPECT_EQ(8, decimator.decimation());
+  // flatscan_max_decimation is never exceeded
+  Observe(monitor, decimator, 0.05, 0.02, 200);
+  EXPECT_EQ(8, decimator.decimation());
+}
+
+TEST(AdaptiveRate, DecimationRecoversBelowBudget) {
+  LoadMonitor monitor;
+  monitor.configure(kBudget, 0.5, 0.001);
+  AdaptiveDecimator decimator;
+  decimator.configure(4);
+  Observe(monitor, decimator, 0.05, 0.02, 30);
+  ASSERT_EQ(4, decimator.decimation());
+
+  // A latency between half the budget and the budget keeps the decimation
+  Observe(monitor, decimator, 0.008, 0.02, 200);
+  EXPECT_EQ(4, decimator.decimation());
+
+  // Every 50 relaxed scans the decimation is lowered by one, down to 1
+  Observe(monitor, decimator, 0.001, 0.02, 10);
+  const int before = decimator.decimation();
+  Observe(monitor, decimator, 0.001, 0.02, 50);
+  EXPECT_EQ(before - 1, decimator.decimation());
+  Observe(monitor, decimator, 0.001, 0.02, 500);
+  EXPECT_EQ(1, decimator.decimation());
+}
+
+TEST(AdaptiveRate, MaximumOfOneDisablesDecimation) {
+  LoadMonitor monitor;
+  monitor.configure(kBudget, 0.5, 0.001);
+  AdaptiveDecimator decimator;
+  decimator.configure(1);
+  Observe(monitor, decimator, 0.05, 0.0, 100);
+  EXPECT_EQ(1, decimator.decimation());
+  for (int i = 0; i < 10; i++) {
+    EXPECT_TRUE(decimator.tick());
+  }
+}
+
+TEST(AdaptiveRate, TickPublishesEveryNthMessage) {
+  LoadMonitor monitor;
+  monitor.configure(kBudget, 0.5, 0.001);
+  AdaptiveDecimator decimator;
+  decimator.configure(4);
+  Observe(monitor, decimator, 0.05, 0.02, 12);
+  ASSERT_EQ(4, decimator.decimation());
+
+  int published = 0;
+  for (int i = 0; i < 40; i++) {
+    published += decimator.tick() ? 1 : 0;
+  }
+  EXPECT_EQ(10, published);
+
+  // Lowering the maximum clamps the current decimation
+  decimator.configure(2);
+  EXPECT_EQ(2, decimator.decimation());
+  decimator.reset();
+  EXPECT_EQ(1, decimator.decimation());
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
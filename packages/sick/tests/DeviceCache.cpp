@@ -0,0 +1,197 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    DeviceCache.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+#include "packages/sick/gems/device_cache.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+constexpr uint32_t kSerialNumber = 12345678;
+constexpr char kAddress[] = "192.168.1.11";
+
+std::string CachePath(const std::string &name) {
+  const std::string path = testing::TempDir() + "/" + name;
+  std::remove(path.c_str());
+  return path;
+}
+
+nlohmann::json Settings(int publishing_frequency_factor) {
+  return {{"channel", 0},
+          {"angle_offset", -90.0},
+          {"publishing_frequency_factor", publishing_frequency_factor}};
+}
+
+// Steps of the driver from connecting to a successful configuration.
+// Returns true if the device was configured, false if configuring was
+// skipped because the device already streams with the settings.
+bool StartDriver(const std::string &path, const nlohmann::json &settings) {
+  DeviceCache cache;
+  EXPECT_TRUE(cache.load(path));
+  const uint32_t serial_number = cache.serialNumber(kAddress);
+  if (serial_number != 0 && cache.isStreaming(serial_number, settings)) {
+    return false;
+  }
+  if (serial_number != 0) {
+    cache.beginConfiguration(serial_number);
+    EXPECT_TRUE(cache.save(path));
+  }
+  // The device is configured; its serial number is known from the first scan
+  cache.setSerialNumber(kAddress, kSerialNumber);
+  cache.finishConfiguration(kSerialNumber, settings);
+  EXPECT_TRUE(cache.save(path));
+  return true;
+}
+
+} // namespace
+
+TEST(DeviceCache, MissingFileIsEmpty) {
+  DeviceCache cache;
+  EXPECT_TRUE(cache.load(CachePath("missing.json")));
+  EXPECT_EQ(0u, cache.serialNumber(kAddress));
+  EXPECT_EQ(nullptr, cache.findDevice(kSerialNumber));
+}
+
+TEST(DeviceCache, InvalidFileIsRejected) {
+  const std::string path = CachePath("invalid.json");
+  std::ofstream(path) << "{ not json";
+  DeviceCache cache;
+  EXPECT_FALSE(cache.load(path));
+  EXPECT_EQ(0u, cache.serialNumber(kAddress));
+}
+
+TEST(DeviceCache, RoundTrip) {
+  const std::string path = CachePath("round_trip.json");
+  DeviceCache cache;
+  cache.setSerialNumber(kAddress, kSerialNumber);
+  cache.device(kSerialNumber)["max_range"] = 40.0;
+  cache.finishConfiguration(kSerialNumber, Settings(1));
+  ASSERT_TRUE(cache.save(path));
+
+  DeviceCache loaded;
+  ASSERT_TRUE(loaded.load(path));
+  EXPECT_EQ(kSerialNumber, loaded.serialNumber(kAddress));
+  const nlohmann::json *device = loaded.findDevice(kSerialNumber);
+  ASSERT_NE(nullptr, device);
+  EXPECT_EQ(40.0, device->at("max_range").get<double>());
+  EXPECT_TRUE(loaded.isStreaming(kSerialNumber, Settings(1)));
+}
+
+TEST(DeviceCache, RestartWithChangedSettingsConfiguresDevice) {
+  const std::string path = CachePath("restart.json");
+  EXPECT_TRUE(StartDriver(path, Settings(1)));
+  // Unchanged settings: the device keeps streaming
+  EXPECT_FALSE(StartDriver(path, Settings(1)));
+  // Changed settings are configured and recorded
+  EXPECT_TRUE(StartDriver(path, Settings(2)));
+  // Going back to the previous settings must configure the device again,
+  // since it still streams with the changed ones
+  EXPECT_TRUE(StartDriver(path, Settings(1)));
+  EXPECT_FALSE(StartDriver(path, Settings(1)));
+}
+
+TEST(DeviceCache, FailedConfigurationForgetsAppliedSettings) {
+  const std::string path = CachePath("failed.json");
+  EXPECT_TRUE(StartDriver(path, Settings(1)));
+
+  // Configuring other settings fails after the device may have changed
+  DeviceCache cache;
+  ASSERT_TRUE(cache.load(path));
+  cache.beginConfiguration(kSerialNumber);
+  ASSERT_TRUE(cache.save(path));
+
+  DeviceCache restarted;
+  ASSERT_TRUE(restarted.load(path));
+  EXPECT_FALSE(restarted.isStreaming(kSerialNumber, Settings(1)));
+  EXPECT_TRUE(StartDriver(path, Settings(1)));
+}
+
+TEST(DeviceCache, BeginConfigurationOfUnknownDevice) {
+  DeviceCache cache;
+  EXPECT_NO_THROW(cache.beginConfiguration(kSerialNumber));
+  EXPECT_EQ(nullptr, cache.findDevice(kSerialNumber));
+  EXPECT_FALSE(cache.isStreaming(kSerialNumber, Settings(1)));
+}
+
+TEST(DeviceCache, SwappedDeviceIsConfigured) {
+  const std::string path = CachePath("swapped.json");
+  EXPECT_TRUE(StartDriver(path, Settings(1)));
+
+  // Another device answers at the cached address. The driver forgets the
+  // applied settings of the connected device before configuring it, as
+  // SickSafetyScanner::validateDeviceIdentity does.
+  constexpr uint32_t kSwappedSerialNumber = 87654321;
+  DeviceCache cache;
+  ASSERT_TRUE(cache.load(path));
+  ASSERT_EQ(kSerialNumber, cache.serialNumber(kAddress));
+  EXPECT_NO_THROW(cache.beginConfiguration(kSwappedSerialNumber));
+  cache.device(kSwappedSerialNumber)["max_range"] = 40.0;
+  cache.setSerialNumber(kAddress, kSwappedSerialNumber);
+  ASSERT_TRUE(cache.save(path));
+  EXPECT_FALSE(cache.isStreaming(kSwappedSerialNumber, Settings(1)));
+  cache.finishConfiguration(kSwappedSerialNumber, Settings(1));
+  ASSERT_TRUE(cache.save(path));
+
+  DeviceCache restarted;
+  ASSERT_TRUE(restarted.load(path));
+  EXPECT_EQ(kSwappedSerialNumber, restarted.serialNumber(kAddress));
+  EXPECT_TRUE(restarted.isStreaming(kSwappedSerialNumber, Settings(1)));
+  // The entry of the previous device is kept for when it returns
+  EXPECT_TRUE(restarted.isStreaming(kSerialNumber, Settings(1)));
+}
+
+TEST(DeviceCache, MalformedEntriesAreReplaced) {
+  const std::string path = CachePath("malformed.json");
+  std::ofstream(path) << R"({ "devices": { "12345678": "text" } })";
+  DeviceCache cache;
+  ASSERT_TRUE(cache.load(path));
+  EXPECT_EQ(nullptr, cache.findDevice(kSerialNumber));
+  EXPECT_NO_THROW(cache.beginConfiguration(kSerialNumber));
+  EXPECT_NO_THROW(cache.finishConfiguration(kSerialNumber, Settings(1)));
+  EXPECT_TRUE(cache.isStreaming(kSerialNumber, Settings(1)));
+
+  std::ofstream(path) << R"({ "devices": [] })";
+  ASSERT_TRUE(cache.load(path));
+  EXPECT_NO_THROW(cache.finishConfiguration(kSerialNumber, Settings(1)));
+  EXPECT_TRUE(cache.isStreaming(kSerialNumber, Settings(1)));
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,289 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    LineExtraction.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "packages/sick/gems/line_extraction.hpp"
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+constexpr float kInvalidRange = 0.05f;
+constexpr float kOutOfRange = 20.0f;
+constexpr float kAngleStep = 0.005f;
+constexpr float kHalfPi = 1.57079632679f;
+
+// Beam angles in [-max_angle, max_angle] with a beam at 0.
+std::vector<float> Angles(float max_angle) {
+  std::vector<float> angles;
+  const int n = static_cast<int>(max_angle / kAngleStep);
+  for (int i = -n; i <= n; i++) {
+    angles.push_back(i * kAngleStep);
+  }
+  return angles;
+}
+
+// Range of a beam to the line x * cos(alpha) + y * sin(alpha) = r.
+float RangeToLine(float angle, float alpha, float r) {
+  return r / std::cos(angle - alpha);
+}
+
+std::chrono::steady_clock::time_point NoDeadline() {
+  return std::chrono::steady_clock::time_point::max();
+}
+
+bool Extract(LineExtractor &extractor, const std::vector<float> &angles,
+             const std::vector<float> &ranges) {
+  return extractor.extract(angles, ranges, kInvalidRange, kOutOfRange,
+                           NoDeadline());
+}
+
+} // namespace
+
+TEST(LineExtraction, CornerIsSplitIntoTwoWalls) {
+  // Walls at x = 2 and y = 1.5 which meet at (2, 1.5). The front wall ends
+  // at y = -2, beyond it the beams are out of range.
+  const std::vector<float> angles = Angles(1.4f);
+  std::vector<float> ranges;
+  uint32_t first_beam = 0;
+  for (const float angle : angles) {
+    if (angle < -0.5f * kHalfPi) {
+      first_beam++;
+      ranges.push_back(kOutOfRange);
+      continue;
+    }
+    const float to_front = RangeToLine(angle, 0.0f, 2.0f);
+    const float to_side =
+        angle > 0.0f ? RangeToLine(angle, kHalfPi, 1.5f) : kOutOfRange;
+    ranges.push_back(std::min(to_front, to_side));
+  }
+
+  LineExtractor extractor;
+  ASSERT_TRUE(Extract(extractor, angles, ranges));
+  const auto &segments = extractor.segments();
+  ASSERT_EQ(2u, segments.size());
+
+  // The beam closest to the corner belongs to both walls. It lies on one of
+  // them and slightly tilts the other.
+  EXPECT_EQ(segments[0].last_beam, segments[1].first_beam);
+  EXPECT_NEAR(0.0f, segments[0].alpha, 1e-3f);
+  EXPECT_NEAR(2.0f, segments[0].r, 1e-3f);
+  EXPECT_NEAR(kHalfPi, segments[1].alpha, 1e-3f);
+  EXPECT_NEAR(1.5f, segments[1].r, 1e-3f);
+  // End points are accurate to about the beam spacing
+  EXPECT_NEAR(2.0f, segments[0].end_x, 2e-2f);
+  EXPECT_NEAR(1.5f, segments[0].end_y, 2e-2f);
+  EXPECT_NEAR(2.0f, segments[1].start_x, 2e-2f);
+  EXPECT_NEAR(1.5f, segments[1].start_y, 2e-2f);
+  EXPECT_EQ(first_beam, segments[0].first_beam);
+  EXPECT_EQ(angles.size() - 1, segments[1].last_beam);
+}
+
+TEST(LineExtraction, SlightlyBentWallIsMergedAgain) {
+  // A wall at a distance of 3 m which bends by 0.018 rad in front of the
+  // sensor. The bend is farther from the chord than split_threshold, but both
+  // halves fit a single line within split_threshold.
+  const std::vector<float> angles = Angles(0.9f);
+  std::vector<float> ranges;
+  for (const float angle : angles) {
+    const float alpha = angle < 0.0f ? -0.009f : 0.009f;
+    ranges.push_back(RangeToLine(angle, alpha, 3.0f * std::cos(alpha)));
+  }
+
+  LineExtractionParams params;
+  params.merge_angle = 0.0f;
+  LineExtractor extractor;
+  extractor.setParams(params);
+  ASSERT_TRUE(Extract(extractor, angles, ranges));
+  ASSERT_EQ(2u, extractor.segments().size());
+
+  params.merge_angle = 0.05f;
+  extractor.setParams(params);
+  ASSERT_TRUE(Extract(extractor, angles, ranges));
+  const auto &segments = extractor.segments();
+  ASSERT_EQ(1u, segments.size());
+  EXPECT_NEAR(0.0f, segments[0].alpha, 1e-3f);
+  EXPECT_EQ(0u, segments[0].first_beam);
+  EXPECT_EQ(angles.size() - 1, segments[0].last_beam);
+  EXPECT_EQ(angles.size(), segments[0].point_count);
+  EXPECT_LE(segments[0].rms_error, params.split_threshold);
+}
+
+TEST(LineExtraction, RangeGapSeparatesCollinearWalls) {
+  // A wall at x = 2 with a doorway to a wall at x = 4. Invalid and out of
+  // range beams on the wall are skipped without splitting it.
+  const std::vector<float> angles = Angles(0.6f);
+  std::vector<float> ranges;
+  for (const float angle : angles) {
+    const bool doorway = std::abs(angle) < 0.15f;
+    ranges.push_back(RangeToLine(angle, 0.0f, doorway ? 4.0f : 2.0f));
+  }
+  ranges[10] = 0.0f;
+  ranges[20] = std::numeric_limits<float>::infinity();
+
+  LineExtractor extractor;
+  ASSERT_TRUE(Extract(extractor, angles, ranges));
+  const auto &segments = extractor.segments();
+  ASSERT_EQ(3u, segments.size());
+  EXPECT_NEAR(2.0f, segments[0].r, 1e-4f);
+  EXPECT_NEAR(4.0f, segments[1].r, 1e-4f);
+  EXPECT_NEAR(2.0f, segments[2].r, 1e-4f);
+  for (const LineSegment &segment : segments) {
+    EXPECT_NEAR(0.0f, segment.alpha, 1e-4f);
+  }
+  EXPECT_EQ(0u, segments[0].first_beam);
+  EXPECT_EQ(segments[0].last_beam - segments[0].first_beam - 1,
+            segments[0].point_count);
+}
+
+TEST(LineExtraction, TotalLeastSquaresFitAndCovariance) {
+  // A wall which lies between 0.5 m and 2.5 m along the line from the foot
+  // point of its normal.
+  constexpr float kAlpha = 0.7f;
+  constexpr float kR = 2.5f;
+  const std::vector<float> angles = Angles(1.2f);
+  std::vector<float> ranges;
+  std::vector<std::size_t> beams;
+  // Positions of the points along the line
+  std::vector<double> positions;
+  for (std::size_t i = 0; i < angles.size(); i++) {
+    const float range = RangeToLine(angles[i], kAlpha, kR);
+    const float along = range * std::sin(angles[i] - kAlpha);
+    if (along >= 0.5f && along <= 2.5f) {
+      ranges.push_back(range);
+      beams.push_back(i);
+      positions.push_back(along);
+    } else {
+      ranges.push_back(kOutOfRange);
+    }
+  }
+  const double n = static_cast<double>(positions.size());
+  double lever = 0.0;
+  for (const double position : positions) {
+    lever += position / n;
+  }
+  double spread = 0.0;
+  for (const double position : positions) {
+    spread += (position - lever) * (position - lever);
+  }
+
+  LineExtractionParams params;
+  params.range_noise = 0.002f;
+  LineExtractor extractor;
+  extractor.setParams(params);
+  ASSERT_TRUE(Extract(extractor, angles, ranges));
+  ASSERT_EQ(1u, extractor.segments().size());
+  const LineSegment segment = extractor.segments()[0];
+  EXPECT_EQ(beams.size(), segment.point_count);
+  EXPECT_EQ(beams.front(), segment.first_beam);
+  EXPECT_EQ(beams.back(), segment.last_beam);
+  EXPECT_NEAR(kAlpha, segment.alpha, 1e-4f);
+  EXPECT_NEAR(kR, segment.r, 1e-4f);
+  EXPECT_NEAR(0.0f, segment.rms_error, 1e-4f);
+  EXPECT_NEAR(kR, segment.start_x * std::cos(kAlpha) +
+                      segment.start_y * std::sin(kAlpha),
+              1e-4f);
+  EXPECT_NEAR(kR, segment.end_x * std::cos(kAlpha) +
+                      segment.end_y * std::sin(kAlpha),
+              1e-4f);
+  // Without residuals the point noise is given by range_noise. A rotation
+  // around the centroid changes r by its position along the line.
+  const double noise = params.range_noise * params.range_noise;
+  EXPECT_NEAR(noise / spread, segment.var_alpha, 1e-3 * segment.var_alpha);
+  EXPECT_NEAR(lever * segment.var_alpha, segment.cov_alpha_r,
+              1e-3 * segment.cov_alpha_r);
+  EXPECT_NEAR(noise / n + lever * lever * segment.var_alpha, segment.var_r,
+              1e-3 * segment.var_r);
+
+  // Points alternately 5 mm in front of and behind the wall. Their residuals
+  // exceed range_noise and thereby set the point noise.
+  for (std::size_t k = 0; k < beams.size(); k++) {
+    const float offset = k % 2 == 0 ? 0.005f : -0.005f;
+    ranges[beams[k]] += offset / std::cos(angles[beams[k]] - kAlpha);
+  }
+  ASSERT_TRUE(Extract(extractor, angles, ranges));
+  ASSERT_EQ(1u, extractor.segments().size());
+  const LineSegment noisy = extractor.segments()[0];
+  EXPECT_NEAR(kAlpha, noisy.alpha, 1e-3f);
+  EXPECT_NEAR(kR, noisy.r, 1e-3f);
+  EXPECT_NEAR(0.005f, noisy.rms_error, 2e-4f);
+  const double variance = noisy.rms_error * noisy.rms_error * n / (n - 2.0);
+  EXPECT_NEAR(variance / spread, noisy.var_alpha, 1e-2 * noisy.var_alpha);
+}
+
+TEST(LineExtraction, DroppedSegmentsMarkTheScanTruncated) {
+  const std::vector<float> angles = Angles(1.4f);
+  std::vector<float> ranges;
+  for (const float angle : angles) {
+    const float to_side =
+        angle > 0.0f ? RangeToLine(angle, kHalfPi, 1.5f) : kOutOfRange;
+    ranges.push_back(std::min(RangeToLine(angle, 0.0f, 2.0f), to_side));
+  }
+
+  LineExtractionParams params;
+  params.max_segments = 1;
+  LineExtractor extractor;
+  extractor.setParams(params);
+  EXPECT_FALSE(Extract(extractor, angles, ranges));
+  EXPECT_EQ(1u, extractor.segments().size());
+
+  params.max_segments = 2;
+  extractor.setParams(params);
+  EXPECT_TRUE(Extract(extractor, angles, ranges));
+  EXPECT_EQ(2u, extractor.segments().size());
+}
+
+TEST(LineExtraction, ExpiredDeadlineMarksTheScanTruncated) {
+  const std::vector<float> angles = Angles(0.5f);
+  std::vector<float> ranges;
+  for (const float angle : angles) {
+    ranges.push_back(RangeToLine(angle, 0.0f, 2.0f));
+  }
+
+  LineExtractor extractor;
+  EXPECT_FALSE(extractor.extract(angles, ranges, kInvalidRange, kOutOfRange,
+                                 std::chrono::steady_clock::now() -
+                                     std::chrono::seconds(1)));
+  EXPECT_TRUE(Extract(extractor, angles, ranges));
+  EXPECT_EQ(1u, extractor.segments().size());
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
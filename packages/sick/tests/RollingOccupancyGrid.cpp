@@ -0,0 +1,230 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    RollingOccupancyGrid.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+#include "packages/sick/gems/rolling_occupancy_grid.hpp"
+
+#include <vector>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+// Grid of 32x32 cells of 1 m, so world and cell coordinates coincide.
+constexpr int kSize = 32;
+constexpr int64_t kTileSize = RollingOccupancyGrid::kTileSize;
+constexpr float kInvalidRange = 0.01f;
+constexpr float kOutOfRange = 1000.0f;
+constexpr float kMaxRange = 1000.0f;
+
+// Casts a single beam from the sensor position.
+void InsertBeam(RollingOccupancyGrid &grid, float x, float y, float angle,
+                float range) {
+  grid.insertScan(x, y, 0.0f, {angle}, {range}, kInvalidRange, kOutOfRange,
+                  kMaxRange);
+}
+
+bool Covers(const std::vector<CellRegion> &regions, int64_t x, int64_t y) {
+  for (const CellRegion &region : regions) {
+    if (x >= region.min_x && x < region.max_x && y >= region.min_y &&
+        y < region.max_y) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Every cell whose value differs from the snapshot has to be in a region.
+void ExpectChangesCovered(const RollingOccupancyGrid &grid,
+                          const std::vector<int8_t> &snapshot,
+                          const CellRegion &snapshot_window) {
+  std::vector<CellRegion> regions;
+  grid.dirtyRegions(regions);
+  const CellRegion window = grid.window();
+  for (int64_t y = window.min_y; y < window.max_y; y++) {
+    for (int64_t x = window.min_x; x < window.max_x; x++) {
+      const bool was_inside = x >= snapshot_window.min_x &&
+                              x < snapshot_window.max_x &&
+                              y >= snapshot_window.min_y &&
+                              y < snapshot_window.max_y;
+      const int8_t before =
+          was_inside ? snapshot[(y - snapshot_window.min_y) * kSize +
+                                (x - snapshot_window.min_x)]
+                     : 0;
+      if (!was_inside || grid.at(x, y) != before) {
+        EXPECT_TRUE(Covers(regions, x, y)) << x << ", " << y;
+      }
+    }
+  }
+}
+
+std::vector<int8_t> Snapshot(const RollingOccupancyGrid &grid) {
+  std::vector<int8_t> cells(kSize * kSize);
+  grid.copyRegion(grid.window(), cells.data());
+  return cells;
+}
+
+} // namespace
+
+TEST(RollingOccupancyGrid, RecenterResetsAndMarksEnteringCells) {
+  RollingOccupancyGrid grid(kSize, 1.0f);
+  ASSERT_EQ(-16, grid.window().min_x);
+  // Occupy the cell at the left border, which shares its storage with the
+  // first column entering on the right
+  InsertBeam(grid, 0.5f, 0.5f, 3.14159265f, 15.7f);
+  ASSERT_GT(grid.at(-16, 0), 0);
+  ASSERT_LT(grid.at(-10, 0), 0);
+  grid.clearDirtyTiles();
+
+  const std::vector<int8_t> snapshot = Snapshot(grid);
+  const CellRegion snapshot_window = grid.window();
+  grid.recenter(3.5f, 0.5f);
+  ASSERT_EQ(-13, grid.window().min_x);
+  for (int64_t x = 16; x < 19; x++) {
+    for (int64_t y = grid.window().min_y; y < grid.window().max_y; y++) {
+      EXPECT_EQ(0, grid.at(x, y));
+    }
+  }
+  EXPECT_EQ(0, grid.at(-16, 0));
+  EXPECT_LT(grid.at(-10, 0), 0);
+  EXPECT_GT(grid.dirtyTileCount(), 0);
+  ExpectChangesCovered(grid, snapshot, snapshot_window);
+
+  // Moving by more than the grid size resets and marks everything
+  grid.clearDirtyTiles();
+  grid.recenter(100.5f, 0.5f);
+  EXPECT_EQ(4, grid.dirtyTileCount());
+  std::vector<CellRegion> regions;
+  grid.dirtyRegions(regions);
+  const CellRegion window = grid.window();
+  for (int64_t y = window.min_y; y < window.max_y; y++) {
+    for (int64_t x = window.min_x; x < window.max_x; x++) {
+      EXPECT_EQ(0, grid.at(x, y));
+      EXPECT_TRUE(Covers(regions, x, y));
+    }
+  }
+
+  // Staying in place changes nothing
+  grid.clearDirtyTiles();
+  grid.recenter(100.7f, 0.2f);
+  EXPECT_EQ(0, grid.dirtyTileCount());
+}
+
+TEST(RollingOccupancyGrid, RaysStopAtTheWindowBorder) {
+  RollingOccupancyGrid grid(kSize, 1.0f);
+  // An obstacle in the last column of the window is hit
+  InsertBeam(grid, 0.5f, 0.5f, 0.0f, 15.0f);
+  EXPECT_GT(grid.at(15, 0), 0);
+  for (int64_t x = 0; x < 15; x++) {
+    EXPECT_LT(grid.at(x, 0), 0);
+  }
+  // The first column on the other side, which shares the storage of x = 16,
+  // is untouched
+  EXPECT_EQ(0, grid.at(-16, 0));
+
+  // Beams beyond the window mark free space up to the border and do not wrap
+  InsertBeam(grid, 0.5f, 2.5f, 0.0f, 40.0f);
+  for (int64_t x = 0; x < 16; x++) {
+    EXPECT_LT(grid.at(x, 2), 0);
+  }
+  for (int64_t x = -16; x < 0; x++) {
+    EXPECT_EQ(0, grid.at(x, 2));
+  }
+  EXPECT_EQ(0, grid.at(16, 2));
+
+  // Diagonal beams leave through the corner
+  InsertBeam(grid, 0.5f, 0.5f, 0.785398f, 100.0f);
+  EXPECT_LT(grid.at(15, 15), 0);
+  EXPECT_EQ(0, grid.at(-16, -16));
+
+  // Sensors outside of the window do not change the grid
+  grid.clearDirtyTiles();
+  InsertBeam(grid, 20.5f, 0.5f, 3.14159265f, 10.0f);
+  EXPECT_EQ(0, grid.dirtyTileCount());
+}
+
+TEST(RollingOccupancyGrid, DirtyRegionsCoverOnlyChangedTiles) {
+  RollingOccupancyGrid grid(4 * kSize, 1.0f);
+  EXPECT_EQ(0, grid.dirtyTileCount());
+
+  // A 270 degree scan of a small room only touches the tiles around it
+  std::vector<float> angles;
+  std::vector<float> ranges;
+  for (int i = 0; i <= 270; i++) {
+    angles.push_back((i - 135) * 3.14159265f / 180.0f);
+    ranges.push_back(5.0f);
+  }
+  grid.insertScan(0.5f, 0.5f, 0.0f, angles, ranges, kInvalidRange,
+                  kOutOfRange, kMaxRange);
+  EXPECT_EQ(4, grid.dirtyTileCount());
+
+  std::vector<CellRegion> regions;
+  grid.dirtyRegions(regions);
+  ASSERT_EQ(4u, regions.size());
+  for (const CellRegion &region : regions) {
+    EXPECT_EQ(kTileSize, region.width());
+    EXPECT_EQ(kTileSize, region.height());
+  }
+  const CellRegion window = grid.window();
+  for (int64_t y = window.min_y; y < window.max_y; y++) {
+    for (int64_t x = window.min_x; x < window.max_x; x++) {
+      if (grid.at(x, y) != 0) {
+        EXPECT_TRUE(Covers(regions, x, y)) << x << ", " << y;
+      }
+    }
+  }
+
+  // Tiles cut by the border of an unaligned window yield partial regions
+  grid.recenter(8.5f, 0.5f);
+  grid.clearDirtyTiles();
+  InsertBeam(grid, 8.5f, 0.5f, 3.14159265f, 200.0f);
+  grid.dirtyRegions(regions);
+  ASSERT_FALSE(regions.empty());
+  bool has_partial = false;
+  for (const CellRegion &region : regions) {
+    EXPECT_GE(region.min_x, grid.window().min_x);
+    EXPECT_LE(region.max_x, grid.window().max_x);
+    has_partial |= region.width() < kTileSize;
+  }
+  EXPECT_TRUE(has_partial);
+
+  grid.clearDirtyTiles();
+  EXPECT_EQ(0, grid.dirtyTileCount());
+  grid.dirtyRegions(regions);
+  EXPECT_TRUE(regions.empty());
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,203 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    ScanAlignment.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "packages/sick/gems/scan_alignment.hpp"
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+constexpr int64_t kMillisecond = 1000000;
+constexpr int64_t kScanPeriod = 25 * kMillisecond;
+constexpr int64_t kTolerance = 10 * kMillisecond;
+// Offset between the sensor clocks and the application clock
+constexpr int64_t kClockOffset = 1000 * kMillisecond;
+
+// A scan taken at the given sensor time and received after the given delay.
+ScanStamp Scan(uint32_t scan_number, int64_t sensor_time,
+               int64_t delay = 2 * kMillisecond) {
+  ScanStamp stamp;
+  stamp.scan_number = scan_number;
+  stamp.sensor_time = sensor_time;
+  stamp.acqtime = sensor_time + kClockOffset + delay;
+  return stamp;
+}
+
+} // namespace
+
+TEST(ScanAlignment, SensorTimeOfDataHeader) {
+  EXPECT_EQ(0, SensorTime(0, 0));
+  EXPECT_EQ((86400000LL + 1500) * kMillisecond, SensorTime(1, 1500));
+}
+
+TEST(ScanAlignment, SensorsOutOfPhaseAreMatchedOnce) {
+  ScanAlignmentBuffer buffer;
+  buffer.configure(2, 4, kTolerance,
+                   ScanAlignmentBuffer::TimeSource::kSensor);
+  std::vector<int> slots;
+  for (uint32_t k = 1; k <= 10; k++) {
+    const int64_t time = k * kScanPeriod;
+    ASSERT_GE(buffer.push(0, Scan(k, time)), 0);
+    // The second sensor scans 4 ms later and is still waited for
+    EXPECT_FALSE(buffer.match(slots));
+    ASSERT_GE(buffer.push(1, Scan(k + 100, time + 4 * kMillisecond)), 0);
+
+    ASSERT_TRUE(buffer.match(slots));
+    ASSERT_EQ(2u, slots.size());
+    EXPECT_EQ(k, buffer.stamp(0, slots[0]).scan_number);
+    EXPECT_EQ(k + 100, buffer.stamp(1, slots[1]).scan_number);
+    EXPECT_EQ(4 * kMillisecond, buffer.spread());
+    EXPECT_EQ(time + kClockOffset + 2 * kMillisecond,
+              buffer.time(0, slots[0]));
+    // Every scan is used in one set only
+    EXPECT_FALSE(buffer.match(slots));
+  }
+  EXPECT_EQ(10u, buffer.matchCount());
+  EXPECT_EQ(0u, buffer.lostScans(0));
+  EXPECT_EQ(0u, buffer.lostScans(1));
+}
+
+TEST(ScanAlignment, ScansBeyondTheToleranceAreNotMatched) {
+  ScanAlignmentBuffer buffer;
+  buffer.configure(2, 4, kTolerance,
+                   ScanAlignmentBuffer::TimeSource::kAcqtime);
+  std::vector<int> slots;
+  // Half a scan period apart
+  for (uint32_t k = 1; k <= 5; k++) {
+    buffer.push(0, Scan(k, k * kScanPeriod));
+    buffer.push(1, Scan(k, k * kScanPeriod + kScanPeriod / 2));
+    EXPECT_FALSE(buffer.match(slots));
+  }
+  EXPECT_EQ(0u, buffer.matchCount());
+
+  // Only the newest set is published, older ones are skipped
+  buffer.configure(2, 4, 15 * kMillisecond,
+                   ScanAlignmentBuffer::TimeSource::kAcqtime);
+  for (uint32_t k = 1; k <= 3; k++) {
+    buffer.push(0, Scan(k, k * kScanPeriod));
+    buffer.push(1, Scan(k, k * kScanPeriod + kScanPeriod / 2));
+  }
+  ASSERT_TRUE(buffer.match(slots));
+  EXPECT_EQ(3u, buffer.stamp(0, slots[0]).scan_number);
+  EXPECT_EQ(3u, buffer.stamp(1, slots[1]).scan_number);
+  EXPECT_EQ(kScanPeriod / 2, buffer.spread());
+  EXPECT_FALSE(buffer.match(slots));
+}
+
+TEST(ScanAlignment, DuplicatedAndLostScansAreCounted) {
+  ScanAlignmentBuffer buffer;
+  buffer.configure(2, 4, kTolerance,
+                   ScanAlignmentBuffer::TimeSource::kSensor);
+  EXPECT_EQ(0, buffer.push(0, Scan(7, 0)));
+  EXPECT_EQ(-1, buffer.push(0, Scan(7, 0)));
+  EXPECT_EQ(1u, buffer.duplicateScans(0));
+  EXPECT_EQ(0u, buffer.lostScans(0));
+
+  // Scans 8 and 9 are missing
+  EXPECT_EQ(1, buffer.push(0, Scan(10, 3 * kScanPeriod)));
+  EXPECT_EQ(2u, buffer.lostScans(0));
+  EXPECT_EQ(2, buffer.push(0, Scan(11, 4 * kScanPeriod)));
+  EXPECT_EQ(2u, buffer.lostScans(0));
+  EXPECT_EQ(0u, buffer.duplicateScans(1));
+  EXPECT_EQ(0u, buffer.lostScans(1));
+
+  // The ring slots are reused once the ring is full
+  EXPECT_EQ(3, buffer.push(0, Scan(12, 5 * kScanPeriod)));
+  EXPECT_EQ(0, buffer.push(0, Scan(13, 6 * kScanPeriod)));
+  EXPECT_EQ(13u, buffer.stamp(0, 0).scan_number);
+}
+
+TEST(ScanAlignment, RestartedSensorStartsOver) {
+  ScanAlignmentBuffer buffer;
+  buffer.configure(2, 4, kTolerance,
+                   ScanAlignmentBuffer::TimeSource::kSensor);
+  std::vector<int> slots;
+  for (uint32_t k = 1; k <= 3; k++) {
+    buffer.push(0, Scan(k, k * kScanPeriod));
+    buffer.push(1, Scan(1000 + k, k * kScanPeriod));
+  }
+  ASSERT_TRUE(buffer.match(slots));
+
+  // The second sensor restarts: its scan numbers and its clock start at 0
+  // again. Its clock offset has to be estimated anew, the first scan is
+  // received with the same delay as before.
+  const int64_t restart = 4 * kScanPeriod;
+  buffer.push(0, Scan(4, restart));
+  ScanStamp first = Scan(1, 0);
+  first.acqtime = restart + kClockOffset + 2 * kMillisecond;
+  EXPECT_EQ(0, buffer.push(1, first));
+  EXPECT_EQ(0u, buffer.lostScans(1));
+
+  ASSERT_TRUE(buffer.match(slots));
+  EXPECT_EQ(4u, buffer.stamp(0, slots[0]).scan_number);
+  EXPECT_EQ(0, slots[1]);
+  EXPECT_EQ(1u, buffer.stamp(1, slots[1]).scan_number);
+  EXPECT_EQ(buffer.time(0, slots[0]), buffer.time(1, slots[1]));
+  EXPECT_EQ(0, buffer.spread());
+}
+
+TEST(ScanAlignment, OffsetFollowsTheSmallestDelay) {
+  ScanAlignmentBuffer buffer;
+  buffer.configure(1, 8, kTolerance,
+                   ScanAlignmentBuffer::TimeSource::kSensor);
+  int slot = buffer.push(0, Scan(1, kScanPeriod, 5 * kMillisecond));
+  EXPECT_EQ(kScanPeriod + kClockOffset + 5 * kMillisecond,
+            buffer.time(0, slot));
+
+  // A smaller delay is taken over immediately
+  slot = buffer.push(0, Scan(2, 2 * kScanPeriod, 2 * kMillisecond));
+  EXPECT_EQ(2 * kScanPeriod + kClockOffset + 2 * kMillisecond,
+            buffer.time(0, slot));
+
+  // A larger delay only moves the offset by 1/64 of the difference, so
+  // jitter hardly affects the aligned time
+  slot = buffer.push(0, Scan(3, 3 * kScanPeriod, 8 * kMillisecond));
+  const int64_t offset = kClockOffset + 2 * kMillisecond +
+                         6 * kMillisecond / 64;
+  EXPECT_EQ(3 * kScanPeriod + offset, buffer.time(0, slot));
+
+  // With the receive times as time source the jitter remains
+  buffer.configure(1, 8, kTolerance,
+                   ScanAlignmentBuffer::TimeSource::kAcqtime);
+  slot = buffer.push(0, Scan(3, 3 * kScanPeriod, 8 * kMillisecond));
+  EXPECT_EQ(3 * kScanPeriod + kClockOffset + 8 * kMillisecond,
+            buffer.time(0, slot));
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
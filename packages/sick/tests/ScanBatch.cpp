@@ -0,0 +1,169 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    ScanBatch.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+#include "packages/sick/gems/scan_batch.hpp"
+
+#include <vector>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+constexpr int64_t kMillisecond = 1000000;
+
+ScanBatchLayout Layout(uint16_t number_of_beams) {
+  ScanBatchLayout layout;
+  layout.serial_number = 12345678;
+  layout.multiplication_factor = 1;
+  layout.scan_time = 40;
+  layout.start_angle = -0.83f;
+  layout.angular_resolution = 0.0017f;
+  layout.number_of_beams = number_of_beams;
+  return layout;
+}
+
+// Appends a scan whose distances are derived from its scan number.
+void Append(ScanBatch &batch, const ScanBatchLayout &layout,
+            uint32_t scan_number, int64_t acqtime) {
+  ScanBatchEntry entry;
+  entry.scan_number = scan_number;
+  entry.acqtime = acqtime;
+  uint16_t *distances = nullptr;
+  uint8_t *reflectivities = nullptr;
+  uint8_t *status = nullptr;
+  batch.append(layout, entry, distances, reflectivities, status);
+  for (uint16_t i = 0; i < layout.number_of_beams; i++) {
+    distances[i] = static_cast<uint16_t>(scan_number * 1000 + i);
+    reflectivities[i] = static_cast<uint8_t>(i);
+    status[i] = 1;
+  }
+}
+
+} // namespace
+
+TEST(ScanBatch, DueWhenFull) {
+  ScanBatch batch;
+  batch.configure(3, 0);
+  EXPECT_FALSE(batch.due(0));
+  const ScanBatchLayout layout = Layout(4);
+  for (uint32_t i = 0; i < 3; i++) {
+    EXPECT_FALSE(batch.due(i * 40 * kMillisecond));
+    Append(batch, layout, i, i * 40 * kMillisecond);
+  }
+  EXPECT_TRUE(batch.due(80 * kMillisecond));
+
+  // The beams of all scans are stored in columns in the order of the scans
+  ASSERT_EQ(3u, batch.size());
+  ASSERT_EQ(12u, batch.distances().size());
+  EXPECT_EQ(12u, batch.reflectivities().size());
+  EXPECT_EQ(12u, batch.status().size());
+  EXPECT_EQ(2003, batch.distances()[11]);
+  EXPECT_EQ(1u, batch.entries()[1].scan_number);
+}
+
+TEST(ScanBatch, DueWhenOldestScanExceedsLatency) {
+  ScanBatch batch;
+  batch.configure(10, 100 * kMillisecond);
+  const ScanBatchLayout layout = Layout(4);
+  Append(batch, layout, 1, 1000 * kMillisecond);
+  Append(batch, layout, 2, 1040 * kMillisecond);
+  EXPECT_FALSE(batch.due(1099 * kMillisecond));
+  EXPECT_TRUE(batch.due(1100 * kMillisecond));
+
+  batch.clear();
+  EXPECT_TRUE(batch.empty());
+  EXPECT_FALSE(batch.due(5000 * kMillisecond));
+}
+
+TEST(ScanBatch, ZeroLatencyOnlyPublishesFullBatches) {
+  ScanBatch batch;
+  batch.configure(2, 0);
+  const ScanBatchLayout layout = Layout(4);
+  Append(batch, layout, 1, 0);
+  EXPECT_FALSE(batch.due(3600000 * kMillisecond));
+  Append(batch, layout, 2, 40 * kMillisecond);
+  EXPECT_TRUE(batch.due(40 * kMillisecond));
+
+  // A batch size of 0 is treated as 1, so every scan is due at once
+  batch.clear();
+  batch.configure(0, 0);
+  Append(batch, layout, 3, 0);
+  EXPECT_TRUE(batch.due(0));
+}
+
+TEST(ScanBatch, ChangedLayoutRequiresFlush) {
+  ScanBatch batch;
+  batch.configure(10, 0);
+  const ScanBatchLayout layout = Layout(4);
+  EXPECT_TRUE(batch.accepts(layout));
+  Append(batch, layout, 1, 0);
+  EXPECT_TRUE(batch.accepts(layout));
+
+  // Changed derived values, e.g. after the sensor was reconfigured
+  ScanBatchLayout reconfigured = layout;
+  reconfigured.angular_resolution *= 2.0f;
+  EXPECT_FALSE(batch.accepts(reconfigured));
+  ScanBatchLayout other_channel = layout;
+  other_channel.channel = 1;
+  EXPECT_FALSE(batch.accepts(other_channel));
+  EXPECT_FALSE(batch.accepts(Layout(2)));
+
+  batch.clear();
+  EXPECT_TRUE(batch.accepts(Layout(2)));
+  Append(batch, Layout(2), 2, 0);
+  EXPECT_EQ(2, batch.layout().number_of_beams);
+  EXPECT_EQ(2u, batch.distances().size());
+}
+
+TEST(ScanBatch, ClearKeepsCapacity) {
+  ScanBatch batch;
+  batch.configure(3, 0);
+  const ScanBatchLayout layout = Layout(100);
+  for (uint32_t i = 0; i < 3; i++) {
+    Append(batch, layout, i, 0);
+  }
+  const uint16_t *distances = batch.distances().data();
+  const ScanBatchEntry *entries = batch.entries().data();
+  batch.clear();
+  for (uint32_t i = 0; i < 3; i++) {
+    Append(batch, layout, i, 0);
+  }
+  EXPECT_EQ(distances, batch.distances().data());
+  EXPECT_EQ(entries, batch.entries().data());
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,135 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    ScanBinning.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+#include "packages/sick/gems/scan_binning.hpp"
+#include "packages/sick/gems/shared_scan_ring.hpp"
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+constexpr float kAngleMin = -1.0f;
+constexpr float kAngleMax = 1.0f;
+
+} // namespace
+
+TEST(ScanBinning, BinHoldsTheMinimumOfItsBeams) {
+  MinRangeBinning binning;
+  binning.configure(4);
+  binning.begin(kAngleMin, kAngleMax);
+  // Bin 0 covers [-1, -0.5), bin 3 [0.5, 1] including the last beam
+  binning.add(-1.0f, 3.0f, kBeamValid);
+  binning.add(-0.9f, 2.0f, kBeamValid);
+  binning.add(-0.6f, 4.0f, kBeamValid);
+  binning.add(0.6f, 1.5f, kBeamValid | kBeamReflector);
+  binning.add(1.0f, 1.0f, kBeamValid);
+  binning.finish();
+
+  ASSERT_EQ(2u, binning.ranges().size());
+  EXPECT_FLOAT_EQ(2.0f, binning.ranges()[0]);
+  EXPECT_FLOAT_EQ(1.0f, binning.ranges()[1]);
+  // Angles are the bin centres
+  EXPECT_FLOAT_EQ(-0.75f, binning.angles()[0]);
+  EXPECT_FLOAT_EQ(0.75f, binning.angles()[1]);
+}
+
+TEST(ScanBinning, EmptyBinsAndUnmeasuredBeamsAreLeftOut) {
+  MinRangeBinning binning;
+  binning.configure(4);
+  binning.begin(kAngleMin, kAngleMax);
+  binning.add(-0.8f, 0.5f, 0);
+  binning.add(-0.7f, 0.5f, kBeamValid | kBeamInfinite);
+  binning.add(-0.6f, 0.5f, kBeamValid | kBeamGlare);
+  binning.add(0.2f, 0.5f, kBeamInfinite);
+  // Contaminated beams are still measured
+  binning.add(-0.2f, 2.5f, kBeamValid | kBeamContamination);
+  binning.add(0.3f, 3.5f, kBeamValid | kBeamContaminationWarning);
+  binning.add(0.4f, 3.0f, kBeamValid);
+  binning.finish();
+
+  ASSERT_EQ(2u, binning.ranges().size());
+  EXPECT_FLOAT_EQ(-0.25f, binning.angles()[0]);
+  EXPECT_FLOAT_EQ(2.5f, binning.ranges()[0]);
+  EXPECT_FLOAT_EQ(0.25f, binning.angles()[1]);
+  EXPECT_FLOAT_EQ(3.0f, binning.ranges()[1]);
+}
+
+TEST(ScanBinning, OutputIsBoundedByTheNumberOfBins) {
+  MinRangeBinning binning;
+  binning.configure(270);
+  for (const int beams : {10, 270, 271, 2750}) {
+    binning.begin(kAngleMin, kAngleMax);
+    for (int i = 0; i < beams; i++) {
+      const float angle =
+          kAngleMin + (kAngleMax - kAngleMin) * i / std::max(beams - 1, 1);
+      binning.add(angle, 1.0f + 0.001f * i, kBeamValid);
+    }
+    binning.finish();
+    EXPECT_LE(binning.ranges().size(), 270u);
+    EXPECT_EQ(binning.ranges().size(), binning.angles().size());
+    // Sparse scans keep every beam, dense scans fill every bin
+    if (beams <= 10) {
+      EXPECT_EQ(static_cast<std::size_t>(beams), binning.ranges().size());
+    } else if (beams >= 2700) {
+      EXPECT_EQ(270u, binning.ranges().size());
+    }
+  }
+  // Beams outside the field of view are counted in the outermost bins
+  binning.begin(kAngleMin, kAngleMax);
+  binning.add(kAngleMin - 0.5f, 2.0f, kBeamValid);
+  binning.add(kAngleMax + 0.5f, 2.0f, kBeamValid);
+  binning.finish();
+  EXPECT_EQ(2u, binning.ranges().size());
+}
+
+TEST(ScanBinning, BinsAreResetForEveryScan) {
+  MinRangeBinning binning;
+  binning.configure(2);
+  binning.begin(kAngleMin, kAngleMax);
+  binning.add(-0.5f, 1.0f, kBeamValid);
+  binning.finish();
+  binning.begin(kAngleMin, kAngleMax);
+  binning.add(0.5f, 2.0f, kBeamValid);
+  binning.finish();
+  ASSERT_EQ(1u, binning.ranges().size());
+  EXPECT_FLOAT_EQ(0.5f, binning.angles()[0]);
+  EXPECT_FLOAT_EQ(2.0f, binning.ranges()[0]);
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,346 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    ScanDatagram.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+#include "capnp/message.h"
+#include "packages/sick/gems/scan_datagram.hpp"
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sick_safetyscanners_base/data_processing/ParseData.h>
+#include <sick_safetyscanners_base/datastructure/PacketBuffer.h>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+// Recorded captures (see the datagram_capture_path parameter) placed in this
+// directory are validated as well. The test is skipped if there are none.
+constexpr char kCaptureDirectory[] = "packages/sick/tests/captures";
+
+void WriteUint16(std::vector<uint8_t> &buffer, std::size_t offset,
+                 uint16_t value) {
+  buffer[offset] = value;
+  buffer[offset + 1] = value >> 8;
+}
+
+void WriteUint32(std::vector<uint8_t> &buffer, std::size_t offset,
+                 uint32_t value) {
+  for (std::size_t i = 0; i < 4; i++) {
+    buffer[offset + i] = value >> (8 * i);
+  }
+}
+
+// Creates a payload with data header, derived values and measurement data.
+std::vector<uint8_t> CreatePayload(uint16_t number_of_beams) {
+  constexpr std::size_t kHeaderSize = 52;
+  constexpr std::size_t kDerivedValuesSize = 20;
+  const std::size_t measurement_size = 4 + 4 * number_of_beams;
+  std::vector<uint8_t> payload(kHeaderSize + kDerivedValuesSize +
+                               measurement_size);
+
+  // Data header
+  payload[0] = 'V';
+  payload[1] = 1;
+  payload[2] = 2;
+  payload[3] = 3;
+  WriteUint32(payload, 4, 12345678);
+  WriteUint32(payload, 8, 87654321);
+  payload[12] = 1;
+  WriteUint32(payload, 16, 4711);
+  WriteUint32(payload, 20, 815);
+  WriteUint16(payload, 24, 17000);
+  WriteUint32(payload, 28, 43200000);
+  WriteUint16(payload, 36, kHeaderSize);
+  WriteUint16(payload, 38, kDerivedValuesSize);
+  WriteUint16(payload, 40, kHeaderSize + kDerivedValuesSize);
+  WriteUint16(payload, 42, measurement_size);
+
+  // Derived values, start angle -47.5 deg, resolution 0.1 deg
+  const std::size_t derived = kHeaderSize;
+  WriteUint16(payload, derived + 0, 1);
+  WriteUint16(payload, derived + 2, number_of_beams);
+  WriteUint16(payload, derived + 4, 40);
+  WriteUint32(payload, derived + 8,
+              static_cast<int32_t>(-47.5 * 4194304.0));
+  WriteUint32(payload, derived + 12, static_cast<int32_t>(0.1 * 4194304.0));
+  WriteUint32(payload, derived + 16, 37);
+
+  // Measurement data with all combinations of status bits
+  const std::size_t measurement = kHeaderSize + kDerivedValuesSize;
+  WriteUint32(payload, measurement, number_of_beams);
+  for (uint16_t i = 0; i < number_of_beams; i++) {
+    const std::size_t beam = measurement + 4 + 4 * i;
+    WriteUint16(payload, beam, 100 + 7 * i);
+    payload[beam + 2] = static_cast<uint8_t>(i * 13);
+    payload[beam + 3] = static_cast<uint8_t>(i & 0x3f);
+  }
+  return payload;
+}
+
+// Canonical encoding of the safety scan created by the base library and ToProto
+kj::Array<capnp::word> ExpectedSafetyScan(const std::vector<uint8_t> &payload,
+                                          float angle_offset) {
+  sick::datastructure::Data data;
+  sick::data_processing::ParseData parser;
+  parser.parseUDPSequence(sick::datastructure::PacketBuffer(payload), data);
+  capnp::MallocMessageBuilder message;
+  auto builder = message.initRoot<::SafetyScanProto>();
+  ToProto(data, builder, angle_offset);
+  return capnp::canonicalize(builder.asReader());
+}
+
+// Canonical encoding of the safety scan created by the direct decoder
+kj::Array<capnp::word> DecodedSafetyScan(const std::vector<uint8_t> &payload,
+                                         float angle_offset) {
+  const sick::datastructure::Data data = ParseScanDatagram(payload);
+  capnp::MallocMessageBuilder message;
+  auto builder = message.initRoot<::SafetyScanProto>();
+  DecodeSafetyScan(payload, data, builder, angle_offset);
+  return capnp::canonicalize(builder.asReader());
+}
+
+// Number of scan points in the safety scan created by the direct decoder
+std::size_t DecodedScanPointCount(const std::vector<uint8_t> &payload) {
+  const sick::datastructure::Data data = ParseScanDatagram(payload);
+  capnp::MallocMessageBuilder message;
+  auto builder = message.initRoot<::SafetyScanProto>();
+  DecodeSafetyScan(payload, data, builder, 0.0f);
+  return builder.getMeasurementData().getScanPoints().size();
+}
+
+void ExpectIdentical(const std::vector<uint8_t> &payload, float angle_offset) {
+  const auto expected = ExpectedSafetyScan(payload, angle_offset);
+  const auto decoded = DecodedSafetyScan(payload, angle_offset);
+  ASSERT_EQ(expected.size(), decoded.size());
+  EXPECT_EQ(0, std::memcmp(expected.begin(), decoded.begin(),
+                           expected.size() * sizeof(capnp::word)));
+}
+
+// Splits a payload into packets with datagram headers
+std::vector<std::vector<uint8_t>> Fragment(const std::vector<uint8_t> &payload,
+                                           std::size_t fragment_size,
+                                           uint32_t identification) {
+  std::vector<std::vector<uint8_t>> packets;
+  for (std::size_t offset = 0; offset < payload.size();
+       offset += fragment_size) {
+    const std::size_t size = std::min(fragment_size, payload.size() - offset);
+    std::vector<uint8_t> packet(ScanDatagramAssembler::kDatagramHeaderSize +
+                                size);
+    std::memcpy(packet.data(), "MS3 ", 4);
+    WriteUint32(packet, 8, payload.size());
+    WriteUint32(packet, 12, identification);
+    WriteUint32(packet, 16, offset);
+    std::copy(payload.begin() + offset, payload.begin() + offset + size,
+              packet.begin() + ScanDatagramAssembler::kDatagramHeaderSize);
+    packets.push_back(packet);
+  }
+  return packets;
+}
+
+} // namespace
+
+TEST(ScanDatagram, AssemblesFragmentsInAnyOrder) {
+  const std::vector<uint8_t> payload = CreatePayload(1000);
+  auto packets = Fragment(payload, 1460, 7);
+  ASSERT_GT(packets.size(), 2u);
+  std::swap(packets.front(), packets.back());
+
+  ScanDatagramAssembler assembler;
+  for (std::size_t i = 0; i + 1 < packets.size(); i++) {
+    EXPECT_FALSE(assembler.addPacket(packets[i].data(), packets[i].size()));
+  }
+  EXPECT_TRUE(
+      assembler.addPacket(packets.back().data(), packets.back().size()));
+  EXPECT_EQ(payload, assembler.payload());
+}
+
+TEST(ScanDatagram, DiscardsIncompleteDatagrams) {
+  const std::vector<uint8_t> first = CreatePayload(1000);
+  const std::vector<uint8_t> second = CreatePayload(500);
+  const auto first_packets = Fragment(first, 1460, 1);
+  const auto second_packets = Fragment(second, 1460, 2);
+
+  ScanDatagramAssembler assembler;
+  EXPECT_FALSE(assembler.addPacket(first_packets[0].data(),
+                                   first_packets[0].size()));
+  bool complete = false;
+  for (const auto &packet : second_packets) {
+    complete = assembler.addPacket(packet.data(), packet.size());
+  }
+  EXPECT_TRUE(complete);
+  EXPECT_EQ(second, assembler.payload());
+}
+
+TEST(ScanDatagram, DuplicatedFragmentsDoNotCompleteDatagrams) {
+  const std::vector<uint8_t> payload = CreatePayload(1000);
+  const auto packets = Fragment(payload, 1460, 3);
+  ASSERT_GT(packets.size(), 2u);
+
+  // The first fragment arrives twice while the last one is still missing
+  ScanDatagramAssembler assembler;
+  EXPECT_FALSE(assembler.addPacket(packets[0].data(), packets[0].size()));
+  EXPECT_FALSE(assembler.addPacket(packets[0].data(), packets[0].size()));
+  for (std::size_t i = 1; i + 1 < packets.size(); i++) {
+    EXPECT_FALSE(assembler.addPacket(packets[i].data(), packets[i].size()));
+  }
+  EXPECT_TRUE(
+      assembler.addPacket(packets.back().data(), packets.back().size()));
+  EXPECT_EQ(payload, assembler.payload());
+}
+
+TEST(ScanDatagram, OverlappingFragmentsAreIgnored) {
+  const std::vector<uint8_t> payload = CreatePayload(1000);
+  const auto packets = Fragment(payload, 1460, 4);
+  // A fragment covering the second half of the first and the start of the
+  // second fragment
+  const auto shifted = Fragment(
+      std::vector<uint8_t>(payload.begin() + 730, payload.end()), 1460, 4);
+  std::vector<uint8_t> overlapping = shifted[0];
+  WriteUint32(overlapping, 8, payload.size());
+  WriteUint32(overlapping, 16, 730);
+
+  ScanDatagramAssembler assembler;
+  EXPECT_FALSE(assembler.addPacket(packets[0].data(), packets[0].size()));
+  EXPECT_FALSE(assembler.addPacket(overlapping.data(), overlapping.size()));
+  bool complete = false;
+  for (std::size_t i = 1; i < packets.size(); i++) {
+    complete = assembler.addPacket(packets[i].data(), packets[i].size());
+  }
+  EXPECT_TRUE(complete);
+  EXPECT_EQ(payload, assembler.payload());
+}
+
+TEST(ScanDatagram, RejectsImplausibleTotalLength) {
+  const auto packets = Fragment(CreatePayload(10), 1460, 5);
+  std::vector<uint8_t> packet = packets[0];
+  WriteUint32(packet, 8, 0xffffffff);
+  ScanDatagramAssembler assembler;
+  EXPECT_FALSE(assembler.addPacket(packet.data(), packet.size()));
+  EXPECT_TRUE(assembler.payload().empty());
+
+  std::stringstream stream;
+  const std::vector<uint8_t> size = {0xff, 0xff, 0xff, 0xff};
+  stream.write(reinterpret_cast<const char *>(size.data()), size.size());
+  std::vector<uint8_t> payload;
+  EXPECT_FALSE(ReadScanDatagramCapture(stream, payload));
+  EXPECT_TRUE(payload.empty());
+}
+
+TEST(ScanDatagram, DecoderMatchesToProto) {
+  for (const uint16_t number_of_beams : {0, 1, 64, 2751}) {
+    for (const float angle_offset : {0.0f, -90.0f, 33.3f}) {
+      SCOPED_TRACE(number_of_beams);
+      const std::vector<uint8_t> payload = CreatePayload(number_of_beams);
+      ExpectIdentical(payload, angle_offset);
+      EXPECT_EQ(number_of_beams, DecodedScanPointCount(payload));
+    }
+  }
+}
+
+TEST(ScanDatagram, DecoderMatchesToProtoWithoutMeasurementData) {
+  std::vector<uint8_t> payload = CreatePayload(10);
+  WriteUint16(payload, 40, 0);
+  WriteUint16(payload, 42, 0);
+  ExpectIdentical(payload, -90.0f);
+  EXPECT_EQ(0u, DecodedScanPointCount(payload));
+}
+
+TEST(ScanDatagram, DecoderMatchesToProtoOnCaptures) {
+  std::vector<std::string> files;
+  if (DIR *directory = opendir(kCaptureDirectory)) {
+    while (const dirent *entry = readdir(directory)) {
+      const std::string name = entry->d_name;
+      if (name.size() > 4 && name.substr(name.size() - 4) == ".bin") {
+        files.push_back(std::string(kCaptureDirectory) + "/" + name);
+      }
+    }
+    closedir(directory);
+  }
+  if (files.empty()) {
+    GTEST_SKIP() << "No captures in " << kCaptureDirectory;
+  }
+
+  for (const std::string &file : files) {
+    SCOPED_TRACE(file);
+    std::ifstream stream(file, std::ios::binary);
+    std::vector<uint8_t> payload;
+    while (ReadScanDatagramCapture(stream, payload)) {
+      ExpectIdentical(payload, -90.0f);
+    }
+  }
+}
+
+TEST(ScanDatagram, DecodedBeamsMatchScanPoints) {
+  const std::vector<uint8_t> payload = CreatePayload(2751);
+  sick::datastructure::Data data;
+  sick::data_processing::ParseData parser;
+  parser.parseUDPSequence(sick::datastructure::PacketBuffer(payload), data);
+
+  ScanBeams expected;
+  ExtractScanBeams(*data.getMeasurementDataPtr(), -90.0f, expected);
+  ScanBeams decoded;
+  DecodeScanBeams(payload, ParseScanDatagram(payload), -90.0f, decoded);
+  ASSERT_EQ(2751u, expected.size());
+  EXPECT_EQ(expected.angles, decoded.angles);
+  EXPECT_EQ(expected.distances, decoded.distances);
+  EXPECT_EQ(expected.reflectivities, decoded.reflectivities);
+  EXPECT_EQ(expected.status, decoded.status);
+}
+
+TEST(ScanDatagram, CaptureRoundTrip) {
+  const std::vector<uint8_t> first = CreatePayload(3);
+  const std::vector<uint8_t> second = CreatePayload(5);
+  std::stringstream stream;
+  WriteScanDatagramCapture(stream, first);
+  WriteScanDatagramCapture(stream, second);
+
+  std::vector<uint8_t> payload;
+  ASSERT_TRUE(ReadScanDatagramCapture(stream, payload));
+  EXPECT_EQ(first, payload);
+  ASSERT_TRUE(ReadScanDatagramCapture(stream, payload));
+  EXPECT_EQ(second, payload);
+  EXPECT_FALSE(ReadScanDatagramCapture(stream, payload));
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
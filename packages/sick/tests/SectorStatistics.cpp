@@ -0,0 +1,125 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    SectorStatistics.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+#include "packages/sick/gems/sector_statistics.hpp"
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+constexpr float kAngleMin = -2.0f;
+constexpr float kAngleMax = 2.0f;
+
+} // namespace
+
+TEST(SectorStatistics, SampleHasHalfWeightAfterHalfLife) {
+  SectorStatistics statistics(1, kAngleMin, kAngleMax);
+  statistics.setHalfLife(10.0);
+  statistics.beginScan();
+  statistics.addBeam(0.0f, true, false, false);
+  EXPECT_DOUBLE_EQ(1.0, statistics.sector(0).beams);
+
+  for (int i = 0; i < 10; i++) {
+    statistics.beginScan();
+  }
+  EXPECT_NEAR(0.5, statistics.sector(0).beams, 1e-9);
+  EXPECT_NEAR(0.5, statistics.sector(0).contamination, 1e-9);
+  for (int i = 0; i < 10; i++) {
+    statistics.beginScan();
+  }
+  EXPECT_NEAR(0.25, statistics.sector(0).beams, 1e-9);
+  EXPECT_EQ(21u, statistics.scans());
+}
+
+TEST(SectorStatistics, BeamsAreCountedInTheirSector) {
+  SectorStatistics statistics(4, kAngleMin, kAngleMax);
+  statistics.beginScan();
+  statistics.addBeam(kAngleMin, false, false, false);
+  statistics.addBeam(-0.5f, false, true, false);
+  statistics.addBeam(0.5f, false, false, true);
+  statistics.addBeam(kAngleMax, true, false, false);
+  // Outside of the field of view
+  statistics.addBeam(kAngleMin - 0.01f, true, true, true);
+  statistics.addBeam(kAngleMax + 0.01f, true, true, true);
+
+  EXPECT_DOUBLE_EQ(1.0, statistics.sector(0).beams);
+  EXPECT_DOUBLE_EQ(1.0, statistics.sector(1).contamination_warning);
+  EXPECT_DOUBLE_EQ(1.0, statistics.sector(2).glare);
+  EXPECT_DOUBLE_EQ(1.0, statistics.sector(3).beams);
+  EXPECT_DOUBLE_EQ(1.0, statistics.sector(3).contamination);
+  double beams = 0.0;
+  for (int i = 0; i < statistics.size(); i++) {
+    beams += statistics.sector(i).beams;
+  }
+  EXPECT_DOUBLE_EQ(4.0, beams);
+}
+
+TEST(SectorStatistics, FractionsStayCorrectOverLongRuns) {
+  // A half-life of one scan doubles the weight every scan, so the counters
+  // are rescaled every few hundred scans
+  SectorStatistics statistics(2, kAngleMin, kAngleMax);
+  statistics.setHalfLife(1.0);
+  for (int scan = 0; scan < 5000; scan++) {
+    statistics.beginScan();
+    for (int beam = 0; beam < 10; beam++) {
+      statistics.addBeam(-1.0f, beam < 3, false, false);
+      statistics.addBeam(1.0f, false, false, beam < 5);
+    }
+  }
+  const SectorStatistics::Sector left = statistics.sector(0);
+  const SectorStatistics::Sector right = statistics.sector(1);
+  // Sum of the geometric series 10 * (1 + 1/2 + 1/4 + ...)
+  EXPECT_NEAR(20.0, left.beams, 1e-9);
+  EXPECT_NEAR(0.3, left.contamination / left.beams, 1e-12);
+  EXPECT_NEAR(0.5, right.glare / right.beams, 1e-12);
+  EXPECT_DOUBLE_EQ(0.0, right.contamination);
+
+  // The decayed state follows a change of the flags
+  for (int scan = 0; scan < 50; scan++) {
+    statistics.beginScan();
+    for (int beam = 0; beam < 10; beam++) {
+      statistics.addBeam(-1.0f, false, false, false);
+    }
+  }
+  EXPECT_NEAR(0.0, statistics.sector(0).contamination, 1e-12);
+
+  statistics.reset();
+  EXPECT_DOUBLE_EQ(0.0, statistics.sector(0).beams);
+  EXPECT_EQ(0u, statistics.scans());
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac
@@ -0,0 +1,172 @@
+// this is for emacs file handling -*- mode: c++; indent-tabs-mode: nil -*-
+
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+
+/*!
+ *  Copyright (C) 2020, SICK AG, Waldkirch
+ *  Copyright (C) 2020, FZI Forschungszentrum Informatik, Karlsruhe, Germany
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!
+ * \file    SharedScanRing.cpp
+ *
+ * \author  agent <agent@local>
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+#include "packages/sick/gems/shared_scan_ring.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace isaac {
+namespace sick_safetyscanners {
+
+namespace {
+
+constexpr uint32_t kSlotCount = 4;
+constexpr uint32_t kMaxBeams = 8;
+
+std::string RingPath(const std::string &name) {
+  const std::string path = testing::TempDir() + "/" + name;
+  std::remove(path.c_str());
+  return path;
+}
+
+// Writes a scan whose beam data is derived from the scan number.
+void WriteScan(SharedScanWriter &writer, uint32_t scan_number,
+               uint32_t number_of_beams) {
+  float *angles = nullptr;
+  uint16_t *distances = nullptr;
+  uint8_t *reflectivities = nullptr;
+  uint8_t *status = nullptr;
+  SharedScanRecord *record =
+      writer.beginWrite(angles, distances, reflectivities, status);
+  record->scan_number = scan_number;
+  record->number_of_beams = number_of_beams;
+  for (uint32_t i = 0; i < number_of_beams; i++) {
+    angles[i] = 0.01f * i;
+    distances[i] = static_cast<uint16_t>(scan_number * 100 + i);
+    reflectivities[i] = static_cast<uint8_t>(i);
+    status[i] = kBeamValid;
+  }
+  writer.commit();
+}
+
+} // namespace
+
+TEST(SharedScanRing, ReaderSeesWrittenScans) {
+  const std::string path = RingPath("shared_scan_ring_read");
+  SharedScanWriter writer;
+  ASSERT_TRUE(writer.open(path, kSlotCount, kMaxBeams)) << writer.error();
+  SharedScanReader reader;
+  ASSERT_TRUE(reader.open(path)) << reader.error();
+  EXPECT_EQ(0u, reader.writeCount());
+
+  WriteScan(writer, 7, kMaxBeams);
+  WriteScan(writer, 8, 3);
+  ASSERT_EQ(2u, reader.writeCount());
+  EXPECT_EQ(1u, reader.latestSequence());
+
+  SharedScanView view;
+  ASSERT_EQ(SharedScanReader::Status::kOk, reader.beginRead(0, view));
+  EXPECT_EQ(0u, view.record->sequence);
+  EXPECT_EQ(7u, view.record->scan_number);
+  ASSERT_EQ(kMaxBeams, view.record->number_of_beams);
+  for (uint32_t i = 0; i < kMaxBeams; i++) {
+    EXPECT_FLOAT_EQ(0.01f * i, view.angles[i]);
+    EXPECT_EQ(700 + i, view.distances[i]);
+    EXPECT_EQ(i, view.reflectivities[i]);
+    EXPECT_EQ(kBeamValid, view.status[i]);
+  }
+  EXPECT_TRUE(reader.endRead(view));
+
+  ASSERT_EQ(SharedScanReader::Status::kOk,
+            reader.beginRead(reader.latestSequence(), view));
+  EXPECT_EQ(8u, view.record->scan_number);
+  EXPECT_EQ(3u, view.record->number_of_beams);
+  EXPECT_EQ(802, view.distances[2]);
+  EXPECT_TRUE(reader.endRead(view));
+
+  EXPECT_EQ(SharedScanReader::Status::kNotAvailable,
+            reader.beginRead(2, view));
+  EXPECT_FALSE(reader.isReplaced());
+}
+
+TEST(SharedScanRing, ReportsOverrunOfSlowReaders) {
+  const std::string path = RingPath("shared_scan_ring_overrun");
+  SharedScanWriter writer;
+  ASSERT_TRUE(writer.open(path, kSlotCount, kMaxBeams)) << writer.error();
+  SharedScanReader reader;
+  ASSERT_TRUE(reader.open(path)) << reader.error();
+
+  for (uint32_t i = 0; i <= kSlotCount; i++) {
+    WriteScan(writer, i, 1);
+  }
+  SharedScanView view;
+  EXPECT_EQ(SharedScanReader::Status::kOverrun, reader.beginRead(0, view));
+  ASSERT_EQ(SharedScanReader::Status::kOk, reader.beginRead(1, view));
+
+  // The writer starts to overwrite the slot while it is read
+  float *angles = nullptr;
+  uint16_t *distances = nullptr;
+  uint8_t *reflectivities = nullptr;
+  uint8_t *status = nullptr;
+  writer.beginWrite(angles, distances, reflectivities, status);
+  EXPECT_FALSE(reader.endRead(view));
+  SharedScanView next;
+  EXPECT_EQ(SharedScanReader::Status::kOverrun, reader.beginRead(1, next));
+  writer.commit();
+  EXPECT_EQ(SharedScanReader::Status::kOverrun, reader.beginRead(1, next));
+  EXPECT_EQ(SharedScanReader::Status::kOk, reader.beginRead(5, next));
+}
+
+TEST(SharedScanRing, ReopenedWriterKeepsOldReadersValid) {
+  const std::string path = RingPath("shared_scan_ring_reopen");
+  SharedScanWriter writer;
+  ASSERT_TRUE(writer.open(path, kSlotCount, kMaxBeams)) << writer.error();
+  WriteScan(writer, 1, kMaxBeams);
+  SharedScanReader old_reader;
+  ASSERT_TRUE(old_reader.open(path)) << old_reader.error();
+
+  ASSERT_TRUE(writer.open(path, 2 * kSlotCount, kMaxBeams)) << writer.error();
+  WriteScan(writer, 2, kMaxBeams);
+
+  // The old mapping is still readable, but receives no further scans
+  EXPECT_TRUE(old_reader.isReplaced());
+  ASSERT_EQ(1u, old_reader.writeCount());
+  SharedScanView view;
+  ASSERT_EQ(SharedScanReader::Status::kOk, old_reader.beginRead(0, view));
+  EXPECT_EQ(1u, view.record->scan_number);
+  EXPECT_EQ(107, view.distances[7]);
+  EXPECT_TRUE(old_reader.endRead(view));
+
+  SharedScanReader reader;
+  ASSERT_TRUE(reader.open(path)) << reader.error();
+  EXPECT_FALSE(reader.isReplaced());
+  ASSERT_EQ(1u, reader.writeCount());
+  ASSERT_EQ(SharedScanReader::Status::kOk, reader.beginRead(0, view));
+  EXPECT_EQ(2u, view.record->scan_number);
+}
+
+} // namespace sick_safetyscanners
+} // namespace isaac